@@ -33,6 +33,7 @@
 */
 
 #include "TVout.h"
+#include <avr/sleep.h>
 
 
 /* Call this to start video output with the default resolution.
@@ -84,6 +85,14 @@ char TVout::begin(uint8_t mode, uint8_t x, uint8_t y) {
 		
 	cursor_x = 0;
 	cursor_y = 0;
+	text_scale = 1;
+	anim_ptr = 0;
+	dec_format = 0;
+	pace_frames = 0;
+	pace_overlay = 0;
+	pace_overruns = 0;
+	pace_late = 0;
+	pace_used = 0;
 	
 	render_setup(mode,x,y,screen);
 	clear_screen();
@@ -155,40 +164,197 @@ unsigned char TVout::vres() {
  *	Will return -1 for dynamic width fonts as this cannot be determined.
 */
 char TVout::char_line() {
-	return ((display.hres*8)/pgm_read_byte(font));
+	return ((display.hres*8)/((pgm_read_byte(font) & 0x7f)*text_scale));
 } // end of char_line
 
 
-/* delay for x ms
- * The resolution is 16ms for NTSC and 20ms for PAL
+/* The line after the last display line, where delay_frame() returns.
+ */
+static int render_stop_line() {
+	return (int)(display.start_render + (display.vres*(display.vscale_const+1)))+1;
+} // end of render_stop_line
+
+
+/* Sleep until the next interrupt, at the latest the next line. The line
+ * interrupt then always starts from sleep, with the same latency, instead
+ * of after whatever instruction a busy loop was at.
+ */
+static void inline idle() {
+	set_sleep_mode(SLEEP_MODE_IDLE);
+	sleep_mode();
+} // end of idle
+
+
+/* Vertical blanks passed since the one of frame f, 0 if it is still ahead.
+ * A vertical blank starts at the end of the last display line, where
+ * delay_frame() returns.
+ */
+static unsigned long blanks_since(unsigned long f, int stop_line) {
+	unsigned long now;
+	int line;
+	uint8_t sreg = SREG;
+	cli();
+	now = display.frames;
+	line = display.scanLine;
+	SREG = sreg;
+
+	if (now < f || (now == f && line <= stop_line))
+		return 0;
+	return now - f + (line > stop_line);
+} // end of blanks_since
+
+
+/* The frame of the last vertical blank passed.
+ */
+static unsigned long last_blank(int stop_line) {
+	unsigned long f;
+	uint8_t sreg = SREG;
+	cli();
+	f = display.frames;
+	SREG = sreg;
+	return f - 1 + blanks_since(f, stop_line);
+} // end of last_blank
+
+
+/* delay for x ms, sleeping in idle mode meanwhile.
  *
  * Arguments:
  *	x:
  *		The number of ms this function should consume.
 */
 void TVout::delay(unsigned int x) {
-	unsigned long time = millis() + x;
-	while(millis() < time);
+	unsigned long start = micros(), time = x * 1000UL;
+	while (micros() - start < time)
+		idle();
 } // end of delay
 
 
 /* Delay for x frames, exits at the end of the last display line.
  * delay_frame(1) is useful prior to drawing so there is little/no flicker.
+ * Sleeps in idle mode meanwhile, waking up every line.
  *
  * Arguments:
  *	x:
  *		The number of frames to delay for.
  */
 void TVout::delay_frame(unsigned int x) {
-	int stop_line = (int)(display.start_render + (display.vres*(display.vscale_const+1)))+1;
-	while (x) {
-		while (display.scanLine != stop_line);
-		while (display.scanLine == stop_line);
-		x--;
-	}
+	int stop_line = render_stop_line();
+	unsigned long f = last_blank(stop_line) + x;
+
+	// a line interrupt between the test and the sleep only costs a line
+	while (x && !blanks_since(f, stop_line))
+		idle();
 } // end of delay_frame
 
 
+/* Start an update that should take a fixed number of frames, end it with
+ * end_frame(). The pace holds from one update to the next whatever each
+ * one takes, as long as it takes no more than its frames. Pacing that was
+ * left for longer than a slot starts over, the pause is not an overrun.
+ *
+ * Arguments:
+ *	frames:
+ *		The number of frames per update, 1 for 60 updates per second on
+ *		NTSC, 50 on PAL.
+ */
+void TVout::begin_frame(uint8_t frames) {
+	unsigned long last = last_blank(render_stop_line());
+
+	// the last vertical blank passed is the first slot start, also after
+	// a pause that left the last slot behind
+	if (!pace_frames || last - pace_base > pace_frames)
+		pace_base = last;
+	pace_frames = frames ? frames : 1;
+	pace_start = micros();
+} // end of begin_frame
+
+
+/* End the update started by begin_frame(): sleep in idle mode until the
+ * vertical blank that ends its slot, so drawing can start there with
+ * little or no flicker. An update that ran past it is counted as an
+ * overrun and the next one starts at once, on the last vertical blank.
+ *
+ * Returns:
+ *	The number of frames the update was late, 0 if on time.
+ */
+uint8_t TVout::end_frame() {
+	int stop_line = render_stop_line();
+	unsigned long deadline = pace_base + pace_frames, late;
+
+	pace_used = micros() - pace_start;
+	if (pace_overlay)
+		draw_overlay();
+	late = blanks_since(deadline, stop_line);
+	if (!late) {
+		while (!blanks_since(deadline, stop_line))
+			idle();
+		pace_base = deadline;
+		return 0;
+	}
+	pace_overruns++;
+	pace_late += late;
+	pace_base = deadline + late - 1;
+	return late > 255 ? 255 : late;
+} // end of end_frame
+
+
+/* Get the number of updates that ran over their frames since begin().
+ */
+unsigned int TVout::overruns() {
+	return pace_overruns;
+} // end of overruns
+
+
+/* Get the number of frames lost to overruns since begin().
+ */
+unsigned int TVout::late_frames() {
+	return pace_late;
+} // end of late_frames
+
+
+/* Get the time the last update took, in % of its frames.
+ */
+uint8_t TVout::frame_load() {
+	unsigned long budget = (unsigned long)pace_frames *
+		(display.lines_frame == _NTSC_LINE_FRAME ? _NTSC_TIME_FRAME : _PAL_TIME_FRAME);
+	unsigned long load;
+
+	if (!budget)
+		return 0;
+	load = pace_used / (budget / 100);
+	return load > 255 ? 255 : load;
+} // end of frame_load
+
+
+/* Show the load, overruns and late frames at the top left of the screen,
+ * drawn by end_frame() with the font selected. The area is left to the
+ * sketch to clear.
+ *
+ * Arguments:
+ *	on:
+ *		1 to show it, 0 to stop.
+ */
+void TVout::frame_overlay(char on) {
+	pace_overlay = on;
+} // end of frame_overlay
+
+
+void TVout::draw_overlay() {
+	uint8_t x = cursor_x, y = cursor_y;
+
+	if (!font)
+		return;
+	print(0, 0, (unsigned int)frame_load());
+	print("% ");
+	print(pace_overruns);
+	print('/');
+	print(pace_late);
+	print(' ');
+	cursor_x = x;
+	cursor_y = y;
+} // end of draw_overlay
+
+
 /* Get the time in ms since begin was called.
  * The resolution is 16ms for NTSC and 20ms for PAL
  *
@@ -196,15 +362,91 @@ void TVout::delay_frame(unsigned int x) {
  *	The time in ms since video generation has started.
 */
 unsigned long TVout::millis() {
-	if (display.lines_frame == _NTSC_LINE_FRAME) {
-		return display.frames * _NTSC_TIME_SCANLINE * _NTSC_LINE_FRAME / 1000;
-	}
-	else {
-		return display.frames * _PAL_TIME_SCANLINE * _PAL_LINE_FRAME / 1000;
-	}
+	unsigned long f = frames();
+	unsigned long frame_cycles = display.lines_frame == _NTSC_LINE_FRAME ? _NTSC_CYCLES_FRAME : _PAL_CYCLES_FRAME;
+
+	// 2000 frames take a whole number of ms, and the rest fits 32 bits
+	return f / 2000 * (frame_cycles / (_CYCLES_PER_US * 1000 / 2000)) +
+		f % 2000 * frame_cycles / (_CYCLES_PER_US * 1000);
 } // end of millis
 
 
+/* Get the number of frames since begin was called, read atomically.
+ *
+ * Returns:
+ *	The number of frames since video generation has started.
+*/
+unsigned long TVout::frames() {
+	unsigned long f;
+	uint8_t sreg = SREG;
+	cli();
+	f = display.frames;
+	SREG = sreg;
+	return f;
+} // end of frames
+
+
+/* Frame count and the cycles into the frame, from the line and TCNT1,
+ * taken together with interrupts off. A frame is the lines 0 to
+ * lines_frame, the last one ending with the interrupt that counts the
+ * frame. A line whose interrupt is pending is counted, so the time never
+ * steps back. From an hbi or vbi hook the line is not counted yet and the
+ * time reads a line early.
+ */
+static unsigned long frame_time(unsigned long * f) {
+	unsigned int line, cycles, line_cycles;
+	uint8_t sreg = SREG;
+	cli();
+	*f = display.frames;
+	line = display.scanLine - 1;
+	cycles = TCNT1;
+	if ((TIFR1 & _BV(TOV1)) && cycles < 512)
+		line++;
+	SREG = sreg;
+
+	if (line > (unsigned int)display.lines_frame) {
+		line -= display.lines_frame + 1;
+		(*f)++;
+	}
+	line_cycles = display.lines_frame == _NTSC_LINE_FRAME ? _NTSC_CYCLES_LINE : _PAL_CYCLES_LINE;
+	return (unsigned long)line * line_cycles + cycles;
+} // end of frame_time
+
+
+/* Get the time in us since begin was called, from whole frames and the
+ * position of the beam, with integer math only. Wraps after about 71 min.
+ *
+ * Returns:
+ *	The time in us since video generation has started.
+*/
+unsigned long TVout::micros() {
+	unsigned long f;
+	unsigned long cycles = frame_time(&f);
+	// the part of a us a frame takes beyond whole ones, half a us on NTSC
+	const uint8_t ntsc_rest = _NTSC_CYCLES_FRAME % _CYCLES_PER_US;
+	const uint8_t pal_rest = _PAL_CYCLES_FRAME % _CYCLES_PER_US;
+
+	if (display.lines_frame == _NTSC_LINE_FRAME)
+		return f * _NTSC_TIME_FRAME + f / _CYCLES_PER_US * ntsc_rest +
+			(f % _CYCLES_PER_US * ntsc_rest + cycles) / _CYCLES_PER_US;
+	return f * _PAL_TIME_FRAME + f / _CYCLES_PER_US * pal_rest +
+		(f % _CYCLES_PER_US * pal_rest + cycles) / _CYCLES_PER_US;
+} // end of micros
+
+
+/* Get how far the current frame has gone, to schedule work within a frame.
+ * A frame lasts 16700.5us on NTSC and 20032us on PAL.
+ *
+ * Returns:
+ *	The time in us since the current frame started.
+*/
+unsigned int TVout::frame_phase() {
+	unsigned long f;
+
+	return frame_time(&f) / _CYCLES_PER_US;
+} // end of frame_phase
+
+
 /* force the number of times to display each line.
  *
  * Arguments:
@@ -582,6 +824,91 @@ void TVout::draw_circle(uint8_t x0, uint8_t y0, uint8_t radius, char c, char fc)
 } // end of draw_circle
 
 
+// quarter wave sine table, sin(i*90/64 degrees)*255
+static PROGMEM const unsigned char sine_table[65] = {
+	0, 6, 13, 19, 25, 31, 37, 44, 50, 56, 62, 68, 74, 80, 86, 92,
+	98, 103, 109, 115, 120, 126, 131, 136, 142, 147, 152, 157, 162, 167, 171, 176,
+	180, 185, 189, 193, 197, 201, 205, 208, 212, 215, 219, 222, 225, 228, 231, 233,
+	236, 238, 240, 242, 244, 246, 247, 249, 250, 251, 252, 253, 254, 254, 255, 255,
+	255
+};
+
+
+/* fixed point sine, 256 steps per turn, result scaled by 255
+ */
+static int16_t isin(uint8_t a) {
+	uint8_t i = a & 0x3f;
+	int16_t s;
+
+	if (a & 0x40)
+		i = 64 - i;
+	s = pgm_read_byte(sine_table + i);
+	return (a & 0x80) ? -s : s;
+} // end of isin
+
+
+/* draw a string with a stroke font, scaled and rotated.
+ * Lines falling partly off the screen are not drawn.
+ *
+ * Arguments:
+ *	x:
+ *		The x coordinate of the upper left corner of the first character.
+ *	y:
+ *		The y coordinate of the upper left corner of the first character.
+ *	str:
+ *		The string to draw.
+ *	vfont:
+ *		The stroke font, see fontstroke.cpp for the format.
+ *	size:
+ *		The height of a character cell in pixels.
+ *	angle:
+ *		The rotation, 256 steps per turn clockwise. 64 draws top to bottom.
+ *	c:
+ *		The color of the text.
+ *		(see color note at the top of this file)
+ */
+void TVout::draw_string(uint8_t x, uint8_t y, const char * str, const unsigned char * vfont,
+						uint8_t size, uint8_t angle, char c) {
+
+	uint8_t first = pgm_read_byte(vfont);
+	uint8_t count = pgm_read_byte(vfont+1);
+	uint8_t advance = pgm_read_byte(vfont+3);
+	int16_t scale = ((uint16_t)size << 8)/pgm_read_byte(vfont+2);
+	int32_t sn = (int32_t)isin(angle)*scale;
+	int32_t cs = (int32_t)isin(angle + 64)*scale;
+	int16_t pen = 0;
+	int16_t px, py, lx = 0, ly = 0;
+	uint8_t ch, p, up;
+	const unsigned char * g;
+
+	while ((ch = *str++)) {
+		if (ch >= first + count && ch >= 'a' && ch <= 'z')
+			ch -= 'a' - 'A';
+		if (ch >= first && ch < first + count) {
+			g = vfont + pgm_read_word(vfont + 4 + (ch - first)*2);
+			up = 1;
+			while ((p = pgm_read_byte(g++)) != 0xFF) {
+				if (p == 0xFE) {
+					up = 1;
+					continue;
+				}
+				int16_t u = pen + (p >> 4);
+				int16_t v = p & 0x0f;
+				px = x + (int16_t)((u*cs - v*sn + 0x8000) >> 16);
+				py = y + (int16_t)((u*sn + v*cs + 0x8000) >> 16);
+				if (!up && px >= 0 && lx >= 0 && py >= 0 && ly >= 0 &&
+					px < display.hres*8 && lx < display.hres*8 && py < display.vres && ly < display.vres)
+					draw_line(lx,ly,px,py,c);
+				lx = px;
+				ly = py;
+				up = 0;
+			}
+		}
+		pen += advance;
+	}
+} // end of draw_string
+
+
 /* place a bitmap at x,y where the bitmap is defined as {width,height,imagedata....}
  *
  * Arguments:
@@ -653,6 +980,608 @@ void TVout::bitmap(uint8_t x, uint8_t y, const unsigned char * bmp,
 } // end of bitmap
 
 
+// copy one decoded row of wb bytes to the screen line at x, clipped
+static void rle_row(uint8_t * line, uint8_t x, const uint8_t * row, uint8_t wb, uint8_t hres) {
+	uint8_t rshift = x&7;
+	uint8_t lshift = 8-rshift;
+	uint8_t cols = hres - x/8;
+	uint8_t k;
+
+	line += x/8;
+	if (!rshift) {
+		if (cols > wb)
+			cols = wb;
+		for (k = 0; k < cols; k++)
+			line[k] = row[k];
+		return;
+	}
+	if (cols > wb+1)
+		cols = wb+1;
+	line[0] = (line[0] & ~(0xff >> rshift)) | (row[0] >> rshift);
+	for (k = 1; k < cols; k++) {
+		if (k == wb)
+			line[k] = (line[k] & (0xff >> rshift)) | (row[k-1] << lshift);
+		else
+			line[k] = (row[k-1] << lshift) | (row[k] >> rshift);
+	}
+}
+
+/* place an RLE compressed bitmap at x,y
+ * The data starts with the decompressed and the compressed size in bytes,
+ * both little endian words, followed by runs in one of two encodings:
+ *	bit runs, as written by convert_image.sh: one byte per run with the
+ *		pixel value in bit 7 and the length 1-127 in bits 0-6.
+ *	byte runs, flagged by bit 15 of the decompressed size: a byte n below
+ *		128 is followed by n+1 literal bytes, a byte n from 128 up by a
+ *		single byte that is repeated n-126 times.
+ * A row is decoded into a buffer a whole byte at a time where possible, only
+ * the ends of bit runs are merged with masks, and then copied to the screen.
+ *
+ * Arguments:
+ *	x:
+ *		The x coordinate of the upper left corner.
+ *	y:
+ *		The y coordinate of the upper left corner.
+ *	rle:
+ *		The compressed bitmap.
+ *	width:
+ *		The width of the image in pixels, a multiple of 8.
+ *		default =0 (the width of the screen)
+ */
+void TVout::rle_bitmap(uint8_t x, uint8_t y, const unsigned char * rle, uint8_t width) {
+	uint8_t row[32];
+	uint8_t wb = width ? width/8 : display.hres;
+	uint8_t col = 0, bit = 0;
+	uint8_t c, v, mask;
+	uint16_t size = pgm_read_word(rle);
+	const unsigned char * end = rle + 4 + pgm_read_word(rle+2);
+	uint16_t count;
+
+	if (wb > 32 || x >= display.hres*8 || y >= display.vres)
+		return;
+	rle += 4;
+
+	if (size & 0x8000) {
+		while (rle < end && y < display.vres) {
+			c = pgm_read_byte(rle++);
+			if (c < 128) {
+				// literal bytes
+				for (count = c+1; count; count--) {
+					row[col] = pgm_read_byte(rle++);
+					if (++col == wb) {
+						rle_row(screen + y*display.hres, x, row, wb, display.hres);
+						col = 0;
+						if (++y >= display.vres)
+							return;
+					}
+				}
+			}
+			else {
+				v = pgm_read_byte(rle++);
+				for (count = c-126; count; count--) {
+					row[col] = v;
+					if (++col == wb) {
+						rle_row(screen + y*display.hres, x, row, wb, display.hres);
+						col = 0;
+						if (++y >= display.vres)
+							return;
+					}
+				}
+			}
+		}
+		return;
+	}
+
+	while (rle < end) {
+		c = pgm_read_byte(rle++);
+		v = (c & 0x80) ? 0xff : 0;
+		count = c & 0x7f;
+		while (count) {
+			if (bit == 0 && count >= 8) {
+				// whole byte
+				row[col] = v;
+				count -= 8;
+				bit = 8;
+			}
+			else {
+				c = 8 - bit;
+				if (c > count)
+					c = count;
+				mask = (0xff >> bit) & ~(0xff >> (bit + c));
+				row[col] = (row[col] & ~mask) | (v & mask);
+				bit += c;
+				count -= c;
+			}
+			if (bit == 8) {
+				bit = 0;
+				if (++col == wb) {
+					rle_row(screen + y*display.hres, x, row, wb, display.hres);
+					col = 0;
+					if (++y >= display.vres)
+						return;
+				}
+			}
+		}
+	}
+} // end of rle_bitmap
+
+
+// next control bit of an LZ stream, a new control byte is read when needed
+static inline uint8_t lz_bit(const unsigned char * & p, uint8_t & ctrl, uint8_t & mask) {
+	if (!mask) {
+		ctrl = pgm_read_byte(p++);
+		mask = 0x80;
+	}
+	uint8_t b = ctrl & mask;
+	mask >>= 1;
+	return b;
+}
+
+/* place an LZ77 compressed bitmap at x,y, as written by img2tv -f lz
+ * The data starts with the decompressed and the compressed size in bytes,
+ * both little endian words. Control bits are read MSB first from bytes taken
+ * out of the stream when the previous one is used up:
+ *	0:	a literal byte follows in the stream
+ *	1:	a match, its length-1 Elias gamma coded, then 0 and 6 bits or 1
+ *		and 11 bits of the offset-1
+ * Matches copy from the part of the image already on the screen, so there is
+ * no window buffer in RAM. This also means the image has to lie completely on
+ * the screen, otherwise nothing is drawn.
+ *
+ * Arguments:
+ *	x:
+ *		The x coordinate of the upper left corner, rounded down to a
+ *		multiple of 8.
+ *	y:
+ *		The y coordinate of the upper left corner.
+ *	lz:
+ *		The compressed bitmap.
+ *	width:
+ *		The width of the image in pixels, a multiple of 8.
+ *		default =0 (the width of the screen)
+ */
+void TVout::lz_bitmap(uint8_t x, uint8_t y, const unsigned char * lz, uint8_t width) {
+	uint8_t wb = width ? width/8 : display.hres;
+	uint8_t skip, col = 0, scol = 0, c;
+	uint8_t ctrl = 0, mask = 0;
+	uint16_t size = pgm_read_word(lz);
+	uint16_t len, off;
+	uint8_t * d, * s;
+
+	if (!wb || x/8 + wb > display.hres || y + size/wb > display.vres)
+		return;
+	skip = display.hres - wb;
+	d = screen + y*display.hres + x/8;
+	lz += 4;
+
+	while (size) {
+		if (!lz_bit(lz, ctrl, mask)) {
+			*d++ = pgm_read_byte(lz++);
+			if (++col == wb) {
+				col = 0;
+				d += skip;
+			}
+			size--;
+			continue;
+		}
+
+		for (c = 0; !lz_bit(lz, ctrl, mask); c++)
+			;
+		for (len = 1; c; c--)
+			len = (len << 1) | (lz_bit(lz, ctrl, mask) ? 1 : 0);
+		len++;
+		c = lz_bit(lz, ctrl, mask) ? 11 : 6;
+		for (off = 0; c; c--)
+			off = (off << 1) | (lz_bit(lz, ctrl, mask) ? 1 : 0);
+		off++;
+
+		// source of the match on the screen
+		if (!skip)
+			s = d - off;
+		else {
+			s = d - (off/wb)*display.hres;
+			c = off % wb;
+			if (col >= c) {
+				s -= c;
+				scol = col - c;
+			}
+			else {
+				s -= c + skip;
+				scol = col + wb - c;
+			}
+		}
+
+		if (len > size)
+			len = size;
+		size -= len;
+		while (len--) {
+			*d++ = *s++;
+			if (++col == wb) {
+				col = 0;
+				d += skip;
+			}
+			if (++scol == wb) {
+				scol = 0;
+				s += skip;
+			}
+		}
+	}
+} // end of lz_bitmap
+
+
+/* place a tiled bitmap at x,y, as written by img2tv -f tile
+ * The map starts with the width and the height in tiles followed by one
+ * byte per tile, row by row, indexing 8x8 tiles in the tile bank. A tile is
+ * 8 bytes, top row first, and one bank is shared by all maps of a project so
+ * repeated blocks are only stored once. Tiles are always drawn in full and
+ * clipped at the edges of the screen.
+ *
+ * Arguments:
+ *	x:
+ *		The x coordinate of the upper left corner, rounded down to a
+ *		multiple of 8.
+ *	y:
+ *		The y coordinate of the upper left corner.
+ *	map:
+ *		The tile map of the image.
+ *	tiles:
+ *		The tile bank the map indexes.
+ */
+void TVout::tile_bitmap(uint8_t x, uint8_t y, const unsigned char * map, const unsigned char * tiles) {
+	uint8_t stride = pgm_read_byte(map);
+	uint8_t tw = stride;
+	uint8_t th = pgm_read_byte(map+1);
+	uint8_t cols = display.hres - x/8;
+	uint8_t tx, ty, r, rows;
+	const unsigned char * t;
+	uint8_t * d;
+
+	if (x/8 >= display.hres)
+		return;
+	if (tw > cols)
+		tw = cols;
+	map += 2;
+	for (ty = 0; ty < th && y < display.vres; ty++) {
+		rows = display.vres - y < 8 ? display.vres - y : 8;
+		d = screen + y*display.hres + x/8;
+		for (tx = 0; tx < tw; tx++) {
+			t = tiles + pgm_read_byte(map + tx)*8;
+			for (r = 0; r < rows; r++)
+				d[r*display.hres] = pgm_read_byte(t + r);
+			d++;
+		}
+		map += stride;
+		y += 8;
+	}
+} // end of tile_bitmap
+
+
+/* place sprite n of a sprite sheet with its hotspot at x,y, as written by
+ * img2tv -f sheet. The sheet starts with the number of sprites followed by
+ * 6 bytes per sprite: the offset of its rows from the start of the sheet,
+ * low byte first, the width, the height and the signed x and y of the
+ * hotspot within the sprite. The rows are laid out as for bitmap(), so the
+ * sprite has to lie on the screen.
+ *
+ * Arguments:
+ *	x:
+ *		The x coordinate of the hotspot.
+ *	y:
+ *		The y coordinate of the hotspot.
+ *	sheet:
+ *		The sprite sheet.
+ *	n:
+ *		The number of the sprite, sprites beyond the sheet are ignored.
+ */
+void TVout::sprite(uint8_t x, uint8_t y, const unsigned char * sheet, uint8_t n) {
+	const unsigned char * e = sheet + 1 + n*6;
+
+	if (n >= pgm_read_byte(sheet))
+		return;
+	bitmap(x - (int8_t)pgm_read_byte(e+4), y - (int8_t)pgm_read_byte(e+5), sheet,
+		pgm_read_word(e), pgm_read_byte(e+2), pgm_read_byte(e+3));
+} // end of sprite
+
+
+// byte runs, the RLE variant flagged in the header
+#define BRLE_BITMAP	3
+
+/* Start decoding a compressed bitmap a few rows at a time, so a full screen
+ * image does not hold up loop() for its whole decoding time. The image is
+ * drawn by following calls to step_decode() and may be placed like with
+ * rle_bitmap() and lz_bitmap(), except that x is rounded down to a multiple
+ * of 8. Starting a new image drops the one being decoded.
+ *
+ * Arguments:
+ *	x:
+ *		The x coordinate of the upper left corner, rounded down to a
+ *		multiple of 8.
+ *	y:
+ *		The y coordinate of the upper left corner.
+ *	data:
+ *		The compressed bitmap.
+ *	format:
+ *		The format of the bitmap:
+ *		RLE_BITMAP	=1	(either RLE variant, as for rle_bitmap())
+ *		LZ_BITMAP	=2	(as for lz_bitmap())
+ *	width:
+ *		The width of the image in pixels, a multiple of 8.
+ *		default =0 (the width of the screen)
+ */
+void TVout::begin_decode(uint8_t x, uint8_t y, const unsigned char * data, uint8_t format, uint8_t width) {
+	uint16_t size = pgm_read_word(data);
+
+	dec_format = 0;
+	dec_wb = width ? width/8 : display.hres;
+	if (!dec_wb || x/8 >= display.hres || y >= display.vres)
+		return;
+	if (format == LZ_BITMAP && (x/8 + dec_wb > display.hres || y + size/dec_wb > display.vres))
+		return;
+	if (format == RLE_BITMAP && (size & 0x8000))
+		format = BRLE_BITMAP;
+	else if (format != RLE_BITMAP && format != LZ_BITMAP)
+		return;
+
+	dec_cols = display.hres - x/8;
+	dec_dst = screen + y*display.hres + x/8;
+	dec_line = y;
+	dec_src = data + 4;
+	dec_end = dec_src + pgm_read_word(data+2);
+	dec_size = size;
+	dec_count = 0;
+	dec_col = 0;
+	dec_bit = 0;
+	dec_mask = 0;
+	dec_format = format;
+} // end of begin_decode
+
+
+// move to the next byte of the image, returns 1 when a row is done
+char TVout::dec_next_col() {
+	dec_dst++;
+	if (++dec_col < dec_wb)
+		return 0;
+	dec_col = 0;
+	dec_dst += display.hres - dec_wb;
+	if (++dec_line >= display.vres)
+		dec_format = 0;
+	return 1;
+} // end of dec_next_col
+
+
+/* Decode the next rows of the image started by begin_decode().
+ * Call it from loop() between other work, or from a vbi hook to decode a
+ * fixed amount each frame, but not from both.
+ *
+ * Arguments:
+ *	rows:
+ *		The number of image rows to decode at most, this bounds the time
+ *		spent here.
+ *
+ * Returns:
+ *	1 if there is more to decode, 0 once the image is complete.
+ */
+char TVout::step_decode(uint8_t rows) {
+	uint8_t c, v, mask;
+	uint16_t off;
+
+	while (rows && dec_format) {
+		if (dec_format == RLE_BITMAP) {
+			if (!dec_count) {
+				if (dec_src >= dec_end) {
+					dec_format = 0;
+					break;
+				}
+				c = pgm_read_byte(dec_src++);
+				dec_val = (c & 0x80) ? 0xff : 0;
+				dec_count = c & 0x7f;
+				continue;
+			}
+			// dec_bit is the number of bits of the current byte done
+			if (!dec_bit && dec_count >= 8) {
+				mask = 0xff;
+				dec_bit = 8;
+				dec_count -= 8;
+			}
+			else {
+				c = 8 - dec_bit;
+				if (c > dec_count)
+					c = dec_count;
+				mask = (0xff >> dec_bit) & ~(0xff >> (dec_bit + c));
+				dec_bit += c;
+				dec_count -= c;
+			}
+			if (dec_col < dec_cols)
+				*dec_dst = (*dec_dst & ~mask) | (dec_val & mask);
+			if (dec_bit < 8)
+				continue;
+			dec_bit = 0;
+		}
+		else if (dec_format == BRLE_BITMAP) {
+			if (!dec_count) {
+				if (dec_src >= dec_end) {
+					dec_format = 0;
+					break;
+				}
+				// dec_bit flags a literal run
+				c = pgm_read_byte(dec_src++);
+				if (c < 128) {
+					dec_count = c+1;
+					dec_bit = 1;
+				}
+				else {
+					dec_count = c-126;
+					dec_bit = 0;
+					dec_val = pgm_read_byte(dec_src++);
+				}
+				continue;
+			}
+			v = dec_bit ? pgm_read_byte(dec_src++) : dec_val;
+			dec_count--;
+			if (dec_col < dec_cols)
+				*dec_dst = v;
+		}
+		else if (dec_count) {
+			// inside an LZ match
+			*dec_dst = *dec_from++;
+			dec_count--;
+			if (++dec_scol == dec_wb) {
+				dec_scol = 0;
+				dec_from += display.hres - dec_wb;
+			}
+		}
+		else {
+			if (!dec_size) {
+				dec_format = 0;
+				break;
+			}
+			if (lz_bit(dec_src, dec_ctrl, dec_mask)) {
+				for (c = 0; !lz_bit(dec_src, dec_ctrl, dec_mask); c++)
+					;
+				for (dec_count = 1; c; c--)
+					dec_count = (dec_count << 1) | (lz_bit(dec_src, dec_ctrl, dec_mask) ? 1 : 0);
+				dec_count++;
+				c = lz_bit(dec_src, dec_ctrl, dec_mask) ? 11 : 6;
+				for (off = 0; c; c--)
+					off = (off << 1) | (lz_bit(dec_src, dec_ctrl, dec_mask) ? 1 : 0);
+				off++;
+
+				dec_from = dec_dst - (off/dec_wb)*display.hres;
+				c = off % dec_wb;
+				if (dec_col >= c) {
+					dec_from -= c;
+					dec_scol = dec_col - c;
+				}
+				else {
+					dec_from -= c + display.hres - dec_wb;
+					dec_scol = dec_col + dec_wb - c;
+				}
+				if (dec_count > dec_size)
+					dec_count = dec_size;
+				dec_size -= dec_count;
+				continue;
+			}
+			*dec_dst = pgm_read_byte(dec_src++);
+			dec_size--;
+		}
+		if (dec_next_col())
+			rows--;
+	}
+	return dec_format != 0;
+} // end of step_decode
+
+
+/* Check if the image started by begin_decode() is complete.
+ *
+ * Returns:
+ *	1 if there is nothing left to decode, otherwise 0.
+ */
+char TVout::decode_done() {
+	return !dec_format;
+} // end of decode_done
+
+
+/* Start playing a delta frame animation at x,y, as written by img2tv -f anim.
+ * The animation starts with a 7 byte header
+ *	{width, height, fps, frames_lo, frames_hi, loop_lo, loop_hi}
+ * followed by one record per frame and, for more than one frame, a record
+ * that turns the last frame back into the first. A record is a list of
+ * spans {row, byte column, length, length bytes} that are XORed into the
+ * screen, ended by a row of 0xFF. Frame 0 is stored against a blank area,
+ * loop is the offset of the record of frame 1 for repeating.
+ * The area is cleared here, frame 0 is drawn by the first anim_update().
+ *
+ * Arguments:
+ *	x:
+ *		The x coordinate of the upper left corner, rounded down to a
+ *		multiple of 8.
+ *	y:
+ *		The y coordinate of the upper left corner.
+ *	anim:
+ *		The animation to play.
+ *	loop:
+ *		1 to repeat the animation, 0 to stop on the last frame.
+ *		default =1
+ */
+void TVout::anim_begin(uint8_t x, uint8_t y, const unsigned char * a, char loop) {
+	uint8_t wb = (pgm_read_byte(a) + 7)/8;
+	uint8_t h = pgm_read_byte(a+1);
+
+	anim_ptr = 0;
+	if (x/8 + wb > display.hres || y + h > display.vres)
+		return;
+	anim = a;
+	anim_base = screen + y*display.hres + x/8;
+	for (uint8_t l = 0; l < h; l++)
+		for (uint8_t b = 0; b < wb; b++)
+			anim_base[l*display.hres + b] = 0;
+	anim_ptr = a + 7;
+	anim_next = 0;
+	anim_loop = loop;
+	anim_acc = 0;
+	anim_pending = 1;
+	anim_last = display.frames;
+} // end of anim_begin
+
+
+/* Advance the animation started by anim_begin(), call it often from loop().
+ * Display frames are counted into animation frames at the rate of the
+ * animation on both PAL and NTSC. Due frames are only applied while no
+ * active line is drawn, so the picture does not tear, otherwise they wait
+ * for the next call. Calling it right after delay_frame(1) always lands in
+ * the vertical blank.
+ *
+ * Returns:
+ *	1 while the animation is playing, 0 once it has ended.
+ */
+char TVout::anim_update() {
+	uint8_t now = display.frames;
+	uint8_t refresh = display.lines_frame == _NTSC_LINE_FRAME ? 60 : 50;
+	uint8_t fps, r, n;
+	uint16_t frames;
+	int stop_line;
+	uint8_t * d;
+
+	if (!anim_ptr)
+		return 0;
+
+	fps = pgm_read_byte(anim+2);
+	while (anim_last != now) {
+		anim_last++;
+		anim_acc += fps;
+		while (anim_acc >= refresh) {
+			anim_acc -= refresh;
+			anim_pending++;
+		}
+	}
+
+	stop_line = (int)(display.start_render + (display.vres*(display.vscale_const+1)));
+	if (!anim_pending || (display.scanLine >= display.start_render && display.scanLine < stop_line))
+		return 1;
+
+	frames = pgm_read_word(anim+3);
+	while (anim_pending) {
+		anim_pending--;
+		while ((r = pgm_read_byte(anim_ptr++)) != 0xFF) {
+			d = anim_base + r*display.hres + pgm_read_byte(anim_ptr++);
+			for (n = pgm_read_byte(anim_ptr++); n; n--)
+				*d++ ^= pgm_read_byte(anim_ptr++);
+		}
+		anim_next++;
+		if (anim_next == frames && (!anim_loop || frames == 1)) {
+			anim_ptr = 0;
+			return 0;
+		}
+		if (anim_next > frames) {
+			// the wrap record brought frame 0 back
+			anim_ptr = anim + pgm_read_word(anim+5);
+			anim_next = 1;
+		}
+	}
+	return 1;
+} // end of anim_update
+
+
 /* shift the pixel buffer in any direction
  * This function will shift the screen in a direction by any distance.
  *
@@ -758,31 +1687,403 @@ static void inline sp(uint8_t x, uint8_t y, char c) {
 } // end of sp
 
 
+/* Point the interrupt at a hook chain: nothing, the one hook itself when it
+ * runs every time, or the walk, which costs about 20 cycles plus 10 a hook.
+ * Call with interrupts off.
+ */
+static void link_chain(struct line_hook * chain, uint8_t n, void (**hook)(), void (*walk)()) {
+#ifdef HOOK_CYCLES
+	*hook = n ? walk : &empty;
+#else
+	if (!n)
+		*hook = &empty;
+	else if (n == 1 && chain[0].every == 1)
+		*hook = chain[0].func;
+	else
+		*hook = walk;
+#endif
+} // end of link_chain
+
+
+/* Take a function out of a hook chain, interrupts off.
+ */
+static void unlink_hook(struct line_hook * chain, uint8_t * n, void (*func)()) {
+	uint8_t i;
+	
+	for (i = 0; i < *n; i++) {
+		if (chain[i].func == func) {
+			for ((*n)--; i < *n; i++)
+				chain[i] = chain[i+1];
+			return;
+		}
+	}
+} // end of unlink_hook
+
+
+/* Insert a function into a hook chain behind those of the same or higher
+ * priority. A function already in the chain is moved.
+ */
+static char insert_hook(struct line_hook * chain, uint8_t * n, void (**hook)(), void (*walk)(),
+	void (*func)(), uint8_t priority, uint8_t every) {
+	uint8_t i;
+	uint8_t sreg = SREG;
+	
+	if (!every)
+		every = 1;
+	cli();
+	unlink_hook(chain, n, func);
+	if (*n == HOOK_CHAIN) {
+		SREG = sreg;
+		return 0;
+	}
+	for (i = *n; i && chain[i-1].priority < priority; i--)
+		chain[i] = chain[i-1];
+	chain[i].func = func;
+	chain[i].priority = priority;
+	chain[i].every = every;
+	// spread hooks with the same divider over different lines
+	chain[i].left = *n % every + 1;
+#ifdef HOOK_CYCLES
+	chain[i].cycles = 0;
+#endif
+	(*n)++;
+	link_chain(chain, *n, hook, walk);
+	SREG = sreg;
+	return 1;
+} // end of insert_hook
+
+
 /* set the vertical blank function call
  * The function passed to this function will be called one per frame. The function should be quickish.
+ * It replaces all the hooks added with add_vbi_hook().
  *
  * Arguments:
  *	func:
  *		The function to call.
  */
 void TVout::set_vbi_hook(void (*func)()) {
-	vbi_hook = func;
+	uint8_t sreg = SREG;
+	cli();
+	vbi_count = 0;
+	insert_hook(vbi_chain, &vbi_count, &vbi_hook, &vbi_walk, func, 0, 1);
+	SREG = sreg;
 } // end of set_vbi_hook
 
 
 /* set the horizonal blank function call
  * This function passed to this function will be called one per scan line.
  * The function MUST be VERY FAST(~2us max).
+ * It replaces all the hooks added with add_hbi_hook().
  *
  * Arguments:
  *	funct:
  *		The function to call.
  */
 void TVout::set_hbi_hook(void (*func)()) {
-	hbi_hook = func;
+	uint8_t sreg = SREG;
+	cli();
+	hbi_count = 0;
+	insert_hook(hbi_chain, &hbi_count, &hbi_hook, &hbi_walk, func, 0, 1);
+	SREG = sreg;
 } // end of set_bhi_hook
 
 
+/* Add a function to the vertical blank hooks, up to HOOK_CHAIN of them.
+ * They are called once per frame, in order of priority, those of the same
+ * priority in the order added. Adding a function again changes its
+ * priority and divider.
+ *
+ * Arguments:
+ *	func:
+ *		The function to call.
+ *	priority:
+ *		Higher is called first.
+ *	every:
+ *		Call it every that many frames.
+ *
+ * Returns:
+ *	1 if added, 0 if the chain is full.
+ */
+char TVout::add_vbi_hook(void (*func)(), uint8_t priority, uint8_t every) {
+	return insert_hook(vbi_chain, &vbi_count, &vbi_hook, &vbi_walk, func, priority, every);
+} // end of add_vbi_hook
+
+
+/* Add a function to the horizontal blank hooks, up to HOOK_CHAIN of them.
+ * They are called each scan line ahead of the line itself, in order of
+ * priority, so the one that needs an exact time goes first. With one hook
+ * that runs every line the interrupt calls it directly; a chain is walked
+ * at about 20 cycles plus 10 a hook, and all of it has to fit the ~2us
+ * before the picture starts, so run what can wait every few lines.
+ *
+ * Arguments:
+ *	func:
+ *		The function to call.
+ *	priority:
+ *		Higher is called first.
+ *	every:
+ *		Call it every that many lines, hooks with the same divider
+ *		take turns on different lines.
+ *
+ * Returns:
+ *	1 if added, 0 if the chain is full.
+ */
+char TVout::add_hbi_hook(void (*func)(), uint8_t priority, uint8_t every) {
+	return insert_hook(hbi_chain, &hbi_count, &hbi_hook, &hbi_walk, func, priority, every);
+} // end of add_hbi_hook
+
+
+/* Remove a function from the vertical blank hooks.
+ *
+ * Arguments:
+ *	func:
+ *		The function to remove.
+ */
+void TVout::remove_vbi_hook(void (*func)()) {
+	uint8_t sreg = SREG;
+	cli();
+	unlink_hook(vbi_chain, &vbi_count, func);
+	link_chain(vbi_chain, vbi_count, &vbi_hook, &vbi_walk);
+	SREG = sreg;
+} // end of remove_vbi_hook
+
+
+/* Remove a function from the horizontal blank hooks.
+ *
+ * Arguments:
+ *	func:
+ *		The function to remove.
+ */
+void TVout::remove_hbi_hook(void (*func)()) {
+	uint8_t sreg = SREG;
+	cli();
+	unlink_hook(hbi_chain, &hbi_count, func);
+	link_chain(hbi_chain, hbi_count, &hbi_hook, &hbi_walk);
+	SREG = sreg;
+} // end of remove_hbi_hook
+
+
+#ifdef HOOK_CYCLES
+/* The most timer cycles, 1/16 us, a call of a hook took since the last
+ * time asked, and start over. Only built with HOOK_CYCLES defined in
+ * video_gen.h.
+ *
+ * Arguments:
+ *	func:
+ *		A function in either hook chain.
+ *
+ * Returns:
+ *	The cycles, 0 if it has not run or is not a hook.
+ */
+unsigned int TVout::hook_cycles(void (*func)()) {
+	struct line_hook * h;
+	unsigned int cycles = 0;
+	uint8_t n;
+	uint8_t sreg = SREG;
+	
+	cli();
+	for (h = hbi_chain, n = hbi_count; n; n--, h++) {
+		if (h->func == func) {
+			cycles = h->cycles;
+			h->cycles = 0;
+		}
+	}
+	for (h = vbi_chain, n = vbi_count; n; n--, h++) {
+		if (h->func == func) {
+			cycles = h->cycles;
+			h->cycles = 0;
+		}
+	}
+	SREG = sreg;
+	return cycles;
+} // end of hook_cycles
+#endif
+
+
+/* Queue work to run in the blank lines, above and below the picture, in
+ * the time the line interrupt leaves there. Each blank line calls the
+ * first function in the queue until it returns 0 or the line budget is
+ * spent, then goes on with the next one. A function that does a piece of
+ * a longer job, a row to copy or a span to decode, returns nonzero to be
+ * called again. It runs inside the interrupt and should take no more than
+ * about 200 cycles a call: a call has to end within the line it started
+ * in, see set_work_budget(), or the next line interrupt comes late.
+ *
+ * Arguments:
+ *	func:
+ *		The function to call with arg.
+ *	arg:
+ *		Passed to func.
+ *
+ * Returns:
+ *	1 if queued, 0 if the queue is full.
+ */
+char TVout::post_work(char (*func)(void *), void * arg) {
+	uint8_t head, next;
+	uint8_t sreg = SREG;
+	cli();
+	head = work_head;
+	next = (head + 1) & (WORK_QUEUE - 1);
+	if (next == work_tail) {
+		SREG = sreg;
+		return 0;
+	}
+	work_queue[head].func = func;
+	work_queue[head].arg = arg;
+	work_head = next;
+	SREG = sreg;
+	return 1;
+} // end of post_work
+
+
+/* Get the number of queued work functions, the one running included.
+ */
+uint8_t TVout::work_pending() {
+	return (work_head - work_tail) & (WORK_QUEUE - 1);
+} // end of work_pending
+
+
+/* Set how far into a blank line work may start a call. The default of 600
+ * cycles leaves room for a call of about 200 cycles and the return from
+ * the interrupt in a line of 1016 (NTSC) or 1024 (PAL) cycles.
+ *
+ * Arguments:
+ *	cycles:
+ *		The cycles from the start of the line, 0 stops running work.
+ */
+void TVout::set_work_budget(unsigned int cycles) {
+	uint8_t sreg = SREG;
+	cli();
+	work_end = cycles;
+	SREG = sreg;
+} // end of set_work_budget
+
+
+// send one byte of a dump, only while the beam is outside the active area
+static void dump_byte(uint8_t c, int stop_line) {
+	while (display.scanLine >= display.start_render && display.scanLine < stop_line);
+#if defined ( UDR0 )
+	while (!(UCSR0A & _BV(UDRE0)));
+	UDR0 = c;
+#else
+	while (!(UCSRA & _BV(UDRE)));
+	UDR = c;
+#endif
+}
+
+static void dump_number(unsigned long n, int stop_line) {
+	char digits[10];
+	uint8_t i = 0;
+
+	do {
+		digits[i++] = '0' + n%10;
+		n /= 10;
+	} while (n);
+	while (i)
+		dump_byte(digits[--i], stop_line);
+}
+
+/* Send the screen over the serial port as a binary PBM image, to capture
+ * what was drawn on a PC with extra/tvcapture.cpp. The header holds the
+ * frame count at the time of the call as a comment:
+ *	P4\n# frame <frames>\n<width> <height>\n
+ * and the rows follow with black pixels as set bits, as PBM has them.
+ * Bytes are only handed to the usart while no active line is drawn, so this
+ * blocks for several frames: at 115200 baud about 50 bytes go out per NTSC
+ * frame, at 1000000 baud a 128x96 screen takes 4 frames. Nothing is drawn
+ * in the meantime, which keeps the picture consistent.
+ * What Serial still has to send goes out first, at its own rate. The usart
+ * is then set up for sending at the given rate, reception is left on, and
+ * its settings are put back once the last byte has gone out.
+ *
+ * Arguments:
+ *	baud:
+ *		The rate of the serial port.
+ *		default =115200
+ */
+void TVout::dump(unsigned long baud) {
+	int stop_line = (int)(display.start_render + (display.vres*(display.vscale_const+1)));
+	uint16_t ubrr = (F_CPU / 4 / baud - 1) / 2;
+	uint16_t i, n = display.hres*display.vres;
+	unsigned long frame, start;
+	uint8_t sreg = SREG;
+	uint8_t old_a, old_b, old_c;
+	uint16_t old_ubrr;
+	unsigned int char_us;
+
+	cli();
+	frame = display.frames;
+	SREG = sreg;
+
+#if defined ( UDR0 )
+	// let Serial drain its buffer, its interrupt clears UDRIE0 when done
+	if (SREG & _BV(SREG_I))
+		while (UCSR0B & _BV(UDRIE0));
+	old_a = UCSR0A;
+	old_b = UCSR0B;
+	old_c = UCSR0C;
+	old_ubrr = UBRR0;
+	// and the last byte shift out, waiting at most a character time,
+	// as TXC0 is never set when nothing was sent
+	if (old_b & _BV(TXEN0)) {
+		char_us = 10 * ((old_a & _BV(U2X0)) ? 8 : 16) * (old_ubrr + 1UL) / _CYCLES_PER_US;
+		start = micros();
+		while (!(UCSR0A & _BV(TXC0)) && micros() - start <= char_us);
+	}
+	UCSR0A = _BV(U2X0) | _BV(TXC0);
+	UBRR0H = ubrr >> 8;
+	UBRR0L = ubrr;
+	UCSR0C = _BV(UCSZ01) | _BV(UCSZ00);
+	UCSR0B = (old_b & ~_BV(UDRIE0)) | _BV(TXEN0);
+#else
+	if (SREG & _BV(SREG_I))
+		while (UCSRB & _BV(UDRIE));
+	old_a = UCSRA;
+	old_b = UCSRB;
+	old_c = 0;
+	old_ubrr = (UBRRH << 8) | UBRRL;
+	if (old_b & _BV(TXEN)) {
+		char_us = 10 * ((old_a & _BV(U2X)) ? 8 : 16) * (old_ubrr + 1UL) / _CYCLES_PER_US;
+		start = micros();
+		while (!(UCSRA & _BV(TXC)) && micros() - start <= char_us);
+	}
+	UCSRA = _BV(U2X) | _BV(TXC);
+	UBRRH = ubrr >> 8;
+	UBRRL = ubrr;
+	UCSRC = _BV(URSEL) | _BV(UCSZ1) | _BV(UCSZ0);
+	UCSRB = (old_b & ~_BV(UDRIE)) | _BV(TXEN);
+#endif
+
+	for (const char * p = "P4\n# frame "; *p; p++)
+		dump_byte(*p, stop_line);
+	dump_number(frame, stop_line);
+	dump_byte('\n', stop_line);
+	dump_number(display.hres*8, stop_line);
+	dump_byte(' ', stop_line);
+	dump_number(display.vres, stop_line);
+	dump_byte('\n', stop_line);
+	for (i = 0; i < n; i++)
+		dump_byte(~display.screen[i], stop_line);
+
+	// put the usart back once the last byte is out, UCSRC is left 8N1
+	// on the usarts that share it with UBRRH
+#if defined ( UDR0 )
+	while (!(UCSR0A & _BV(TXC0)));
+	UBRR0 = old_ubrr;
+	UCSR0C = old_c;
+	UCSR0A = (old_a & _BV(U2X0)) | _BV(TXC0);
+	UCSR0B = old_b;
+#else
+	(void)old_c;
+	while (!(UCSRA & _BV(TXC)));
+	UBRRH = old_ubrr >> 8;
+	UBRRL = old_ubrr;
+	UCSRA = (old_a & _BV(U2X)) | _BV(TXC);
+	UCSRB = old_b;
+#endif
+} // end of dump
+
+
 /* Simple tone generation
  *
  * Arguments:
@@ -796,6 +2097,7 @@ void TVout::tone(unsigned int frequency) {
 
 
 /* Simple tone generation
+ * Does nothing while an audio hook, TVoutAudio or TVoutPCM, owns timer 2.
  *
  * Arguments:
  *	frequency:
@@ -806,8 +2108,9 @@ void TVout::tone(unsigned int frequency) {
  */
 void TVout::tone(unsigned int frequency, unsigned long duration_ms) {
 
-	if (frequency == 0)
+	if (frequency == 0 || timer2_owned)
 		return;
+	stop();
 
 #define TIMER 2
 	//this is init code
@@ -857,8 +2160,11 @@ void TVout::tone(unsigned int frequency, unsigned long duration_ms) {
     }
     TCCR2B = prescalarbits;
 
-	if (duration_ms > 0)
-		remainingToneVsyncs = duration_ms*60/1000; //60 here represents the framerate
+	if (duration_ms > 0) {
+		// in frames of the current standard, rounded
+		unsigned int frame_us = display.lines_frame == _NTSC_LINE_FRAME ? _NTSC_TIME_FRAME : _PAL_TIME_FRAME;
+		remainingToneVsyncs = (duration_ms*1000 + frame_us/2)/frame_us;
+	}
 	else
 		remainingToneVsyncs = -1;
  
@@ -869,9 +2175,63 @@ void TVout::tone(unsigned int frequency, unsigned long duration_ms) {
     TCCR2A |= _BV(COM2A0);
 } // end of tone
 
-/* Stops tone generation
+/* Stops tone generation, unless an audio hook owns timer 2.
  */
 void TVout::noTone() {
+	if (timer2_owned)
+		return;
 	TCCR2B = 0;
 	PORT_SND &= ~(_BV(SND_PIN)); //set pin 11 to 0
-} // end of noTone
\ No newline at end of file
+} // end of noTone
+
+
+/* Play a song in the background, replacing the one playing.
+ * The song is a PROGMEM list of SONG_NOTE(frequency, ms) and SONG_REST(ms)
+ * entries ended by SONG_END:
+ *	PROGMEM const unsigned int song[] = {
+ *		SONG_NOTE(659, 120), SONG_REST(20), SONG_NOTE(698, 120), SONG_END
+ *	};
+ * Notes are switched in the vertical sync, so the song costs no time in
+ * loop() and keeps its length on PAL and NTSC alike; every note ends on the
+ * frame closest to its time. Playing starts with the next frame. tone()
+ * stops the song. Does nothing while an audio hook owns timer 2.
+ *
+ * Arguments:
+ *	song:
+ *		The song to play.
+ */
+void TVout::play(const unsigned int * song) {
+	// half a frame early, so notes end on the closest frame
+	long left = display.lines_frame == _NTSC_LINE_FRAME ? -_NTSC_TIME_FRAME/2 : -_PAL_TIME_FRAME/2;
+
+	uint8_t sreg = SREG;
+
+	if (timer2_owned)
+		return;
+	DDR_SND |= _BV(SND_PIN);
+	cli();
+	song_left = left;
+	song_note = song;
+	SREG = sreg;
+} // end of play
+
+
+/* Stop the song or the tone playing, if any, and silence the speaker.
+ */
+void TVout::stop() {
+	uint8_t sreg = SREG;
+
+	cli();
+	song_note = 0;
+	remainingToneVsyncs = 0;
+	SREG = sreg;
+	noTone();
+} // end of stop
+
+
+/* Returns:
+ *	1 while a song is playing, 0 once it has ended or was stopped.
+ */
+char TVout::is_playing() {
+	return song_note != 0;
+} // end of is_playing
\ No newline at end of file
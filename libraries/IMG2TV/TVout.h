@@ -56,6 +56,24 @@ application as possible.
 #define LEFT					2
 #define RIGHT					3
 
+#define RLE_BITMAP				1
+#define LZ_BITMAP				2
+
+// Song entries for play(): a note of f Hz (31 Hz and up) or a rest, lasting
+// ms milliseconds. The timer 2 settings are worked out by the compiler.
+#define _SONG_OCR(f, div)		(F_CPU / 2 / (div) / (f) - 1)
+#define _SONG_TIMER(f) \
+	(_SONG_OCR(f, 1) < 256 ? 0x100 | _SONG_OCR(f, 1) : \
+	_SONG_OCR(f, 8) < 256 ? 0x200 | _SONG_OCR(f, 8) : \
+	_SONG_OCR(f, 32) < 256 ? 0x300 | _SONG_OCR(f, 32) : \
+	_SONG_OCR(f, 64) < 256 ? 0x400 | _SONG_OCR(f, 64) : \
+	_SONG_OCR(f, 128) < 256 ? 0x500 | _SONG_OCR(f, 128) : \
+	_SONG_OCR(f, 256) < 256 ? 0x600 | _SONG_OCR(f, 256) : \
+	0x700 | _SONG_OCR(f, 1024))
+#define SONG_NOTE(f, ms)		_SONG_TIMER(f), (ms)
+#define SONG_REST(ms)			0, (ms)
+#define SONG_END				0, 0
+
 #define DEC 10
 #define HEX 16
 #define OCT 8
@@ -86,6 +104,17 @@ public:
 	void delay(unsigned int x);
 	void delay_frame(unsigned int x);
 	unsigned long millis();
+	unsigned long frames();
+	unsigned long micros();
+	unsigned int frame_phase();
+	
+	//frame pacing functions
+	void begin_frame(uint8_t frames = 1);
+	uint8_t end_frame();
+	unsigned int overruns();
+	unsigned int late_frames();
+	uint8_t frame_load();
+	void frame_overlay(char on);
 	
 	//override setup functions
 	void force_vscale(char sfactor);
@@ -103,21 +132,54 @@ public:
 	void draw_rect(uint8_t x0, uint8_t y0, uint8_t w, uint8_t h, char c, char fc = -1); 
 	void draw_circle(uint8_t x0, uint8_t y0, uint8_t radius, char c, char fc = -1);
 	void bitmap(uint8_t x, uint8_t y, const unsigned char * bmp, uint16_t i = 0, uint8_t width = 0, uint8_t lines = 0);
+	void rle_bitmap(uint8_t x, uint8_t y, const unsigned char * rle, uint8_t width = 0);
+	void lz_bitmap(uint8_t x, uint8_t y, const unsigned char * lz, uint8_t width = 0);
+	void tile_bitmap(uint8_t x, uint8_t y, const unsigned char * map, const unsigned char * tiles);
+	void sprite(uint8_t x, uint8_t y, const unsigned char * sheet, uint8_t n);
+	void draw_string(uint8_t x, uint8_t y, const char * str, const unsigned char * vfont, uint8_t size, uint8_t angle, char c);
+	
+	//resumable image decoding
+	void begin_decode(uint8_t x, uint8_t y, const unsigned char * data, uint8_t format, uint8_t width = 0);
+	char step_decode(uint8_t rows);
+	char decode_done();
+	
+	//animation functions
+	void anim_begin(uint8_t x, uint8_t y, const unsigned char * anim, char loop = 1);
+	char anim_update();
 	
 	//hook setup functions
 	void set_vbi_hook(void (*func)());
 	void set_hbi_hook(void (*func)());
+	char add_vbi_hook(void (*func)(), uint8_t priority = 0, uint8_t every = 1);
+	char add_hbi_hook(void (*func)(), uint8_t priority = 0, uint8_t every = 1);
+	void remove_vbi_hook(void (*func)());
+	void remove_hbi_hook(void (*func)());
+#ifdef HOOK_CYCLES
+	unsigned int hook_cycles(void (*func)());
+#endif
+
+	//deferred work functions
+	char post_work(char (*func)(void *), void * arg = 0);
+	uint8_t work_pending();
+	void set_work_budget(unsigned int cycles);
+
+	//debug functions
+	void dump(unsigned long baud = 115200);
 
 	//tone functions
 	void tone(unsigned int frequency, unsigned long duration_ms);
 	void tone(unsigned int frequency);
 	void noTone();
+	void play(const unsigned int * song);
+	void stop();
+	char is_playing();
 	
 //The following function definitions can be found in TVoutPrint.cpp
 //printing functions
 	void print_char(uint8_t x, uint8_t y, unsigned char c);
 	void set_cursor(uint8_t, uint8_t);
-	void select_font(const unsigned char * f);
+	void select_font(const unsigned char * f, const unsigned char * map = 0);
+	void set_text_scale(uint8_t s);
 
     void write(uint8_t);
     void write(const char *str);
@@ -163,13 +225,60 @@ public:
 	
 	void printPGM(const char[]);
 	void printPGM(uint8_t, uint8_t, const char[]);
+	void printfPGM(uint8_t, uint8_t, const char[], ...);
 	
 private:
 	uint8_t cursor_x,cursor_y;
+	uint8_t text_scale;
 	const unsigned char * font;
+	const unsigned char * codepage;
+	uint16_t utf8_cp;
+	uint8_t utf8_left;
+	char map_ascii;
+	const unsigned char * anim;
+	const unsigned char * anim_ptr;
+	uint8_t * anim_base;
+	uint16_t anim_next;
+	uint8_t anim_acc;
+	uint8_t anim_pending;
+	uint8_t anim_last;
+	char anim_loop;
+	const unsigned char * dec_src;
+	const unsigned char * dec_end;
+	uint8_t * dec_dst;
+	uint8_t * dec_from;
+	uint16_t dec_size;
+	uint16_t dec_count;
+	volatile uint8_t dec_format;
+	uint8_t dec_line;
+	uint8_t dec_wb;
+	uint8_t dec_cols;
+	uint8_t dec_col;
+	uint8_t dec_scol;
+	uint8_t dec_bit;
+	uint8_t dec_val;
+	uint8_t dec_ctrl;
+	uint8_t dec_mask;
+	unsigned long pace_base;
+	unsigned long pace_start;
+	unsigned long pace_used;
+	unsigned int pace_overruns;
+	unsigned int pace_late;
+	uint8_t pace_frames;
+	char pace_overlay;
+	
+	void draw_overlay();
 	
+	char dec_next_col();
 	void inc_txtline();
+	void print_char_scaled(uint8_t x, uint8_t y, unsigned char c);
+	uint8_t map_codepoint(uint16_t cp);
     void printNumber(unsigned long, uint8_t);
+	void print_dec(uint32_t n, uint8_t digits);
+	void print_hex(uint32_t n, uint8_t digits, char a);
+	void print_pad(uint8_t n, char c);
+	static uint8_t dec_digits(uint32_t n);
+	static uint8_t hex_digits(uint32_t n);
     void printFloat(double, uint8_t);
 };
 
@@ -20,12 +20,78 @@ Modified 23 November 2006 by David A. Mellis
 */
 
 #include <math.h>
+#include <stdarg.h>
+#include <string.h>
 #include <avr/pgmspace.h>
 
 #include "TVout.h"
 
-void TVout::select_font(const unsigned char * f) {
+// pixel doubling table, bit n of the nibble becomes bits 2n and 2n+1 of the byte
+static PROGMEM const unsigned char scale2x[16] = {
+	0x00,0x03,0x0C,0x0F,0x30,0x33,0x3C,0x3F,
+	0xC0,0xC3,0xCC,0xCF,0xF0,0xF3,0xFC,0xFF
+};
+
+// pixel tripling table, each nibble becomes 12 bits
+static PROGMEM const uint16_t scale3x[16] = {
+	0x000,0x007,0x038,0x03F,0x1C0,0x1C7,0x1F8,0x1FF,
+	0xE00,0xE07,0xE38,0xE3F,0xFC0,0xFC7,0xFF8,0xFFF
+};
+
+// powers of ten for digit generation by subtraction
+static PROGMEM const uint32_t powers10[10] = {
+	1UL,10UL,100UL,1000UL,10000UL,100000UL,1000000UL,
+	10000000UL,100000000UL,1000000000UL
+};
+
+// 0.5 in the last printed digit of a 16 bit fraction, by precision
+static PROGMEM const uint16_t qround[5] = {
+	32768,3277,328,33,3
+};
+
+// printed by printfPGM() for a null %s or %S
+static PROGMEM const char null_str[] = "(null)";
+
+/* Select the font used by the print functions.
+ *
+ * Arguments:
+ *	f:
+ *		The font to use. Fonts with bit 7 of the width set are bit packed,
+ *		their rows follow each other without padding to whole bytes.
+ *	map:
+ *		Code page map of the font. When given, text is decoded as UTF-8 and
+ *		every printable code point is looked up in the map, unmapped code
+ *		points print as '?'. The map is a table of runs sorted by code point:
+ *			{count, {first_lo, first_hi, length, char} * count}
+ *		where code point first+i is drawn as character char+i. When the
+ *		first run maps ' ' to 0x7F onto themselves, ASCII bypasses the
+ *		lookup; subset maps, which move ASCII, look it up too.
+ *		default =0 (print bytes as they are)
+ */
+void TVout::select_font(const unsigned char * f, const unsigned char * map) {
 	font = f;
+	codepage = map;
+	utf8_left = 0;
+	map_ascii = 0;
+	if (map) {
+		uint16_t first = pgm_read_word(map+1);
+		map_ascii = first <= ' ' && first + pgm_read_byte(map+3) > 0x7F &&
+			pgm_read_byte(map+4) == first;
+	}
+}
+
+/* Set the magnification used by print_char and the print functions.
+ *
+ * Arguments:
+ *	s:
+ *		The scale factor 1 to 4, 1 draws the font at its native size.
+ */
+void TVout::set_text_scale(uint8_t s) {
+	if (s < 1)
+		s = 1;
+	else if (s > 4)
+		s = 4;
+	text_scale = s;
 }
 
 /*
@@ -35,14 +101,155 @@ void TVout::select_font(const unsigned char * f) {
 void TVout::print_char(uint8_t x, uint8_t y, unsigned char c) {
 
 	c -= pgm_read_byte(font+2);
-	bitmap(x,y,font,(c*pgm_read_byte(font+1))+3,pgm_read_byte(font),pgm_read_byte(font+1));
+	// packed fonts have bit 7 of the width set, so they are above 8 too
+	if (text_scale > 1 || pgm_read_byte(font) > 8)
+		print_char_scaled(x,y,c);
+	else
+		bitmap(x,y,font,(c*pgm_read_byte(font+1))+3,pgm_read_byte(font),pgm_read_byte(font+1));
+}
+
+/*
+ * print glyph c of the current font magnified by text_scale.
+ * Each glyph row is expanded a byte at a time through the scale tables,
+ * shifted once into place and then stored text_scale times by stepping the
+ * screen pointer one line down. Glyphs up to 16 pixels wide are supported.
+ * Bit packed fonts and those wider than 8 pixels always come through here,
+ * also at scale 1.
+ */
+void TVout::print_char_scaled(uint8_t x, uint8_t y, unsigned char c) {
+	uint8_t w = pgm_read_byte(font);
+	uint8_t h = pgm_read_byte(font+1);
+	uint8_t packed = w & 0x80;
+	uint8_t rb, row[2];
+	uint16_t bit;
+	uint8_t n;
+	uint8_t rshift = x&7;
+	uint8_t lshift = 8-rshift;
+	uint8_t cols, bits, b, k;
+	uint8_t e[9], m[9];
+	const unsigned char * g;
+	uint8_t * p;
+
+	w &= 0x7f;
+	rb = (w+7)/8;
+	n = rb*text_scale;
+	if (x >= display.hres*8 || y >= display.vres || n > 8)
+		return;
+
+	// mask of the scaled glyph cell, shifted to x
+	bits = w*text_scale;
+	for (k = 0; k < n; k++) {
+		if (bits >= 8) {
+			m[k] = 0xff;
+			bits -= 8;
+		}
+		else {
+			m[k] = ~(0xff >> bits);
+			bits = 0;
+		}
+	}
+	m[n] = m[n-1] << lshift;
+	for (k = n-1; k > 0; k--)
+		m[k] = (m[k-1] << lshift) | (m[k] >> rshift);
+	m[0] >>= rshift;
+
+	cols = rshift ? n+1 : n;
+	if (cols > display.hres - x/8)
+		cols = display.hres - x/8;
+
+	g = font + 3 + (uint16_t)c*h*rb;
+	bit = (uint16_t)c*h*w;
+	p = screen + (uint16_t)y*display.hres + x/8;
+	for (uint8_t l = 0; l < h; l++) {
+		// fetch one glyph row, left aligned
+		if (packed) {
+			g = font + 3 + bit/8;
+			uint32_t v = ((uint32_t)pgm_read_byte(g) << 16) |
+				((uint16_t)pgm_read_byte(g+1) << 8) | pgm_read_byte(g+2);
+			v <<= bit & 7;
+			row[0] = v >> 16;
+			row[1] = v >> 8;
+			bit += w;
+		}
+		else {
+			for (k = 0; k < rb; k++)
+				row[k] = pgm_read_byte(g++);
+		}
+
+		// expand it
+		for (k = 0; k < rb; k++) {
+			b = row[k];
+			uint8_t * d = e + k*text_scale;
+			if (text_scale == 1)
+				d[0] = b;
+			else if (text_scale == 2) {
+				d[0] = pgm_read_byte(scale2x + (b >> 4));
+				d[1] = pgm_read_byte(scale2x + (b & 0x0f));
+			}
+			else if (text_scale == 3) {
+				uint16_t hi = pgm_read_word(scale3x + (b >> 4));
+				uint16_t lo = pgm_read_word(scale3x + (b & 0x0f));
+				d[0] = hi >> 4;
+				d[1] = (hi << 4) | (lo >> 8);
+				d[2] = lo;
+			}
+			else {
+				uint8_t hi = pgm_read_byte(scale2x + (b >> 4));
+				uint8_t lo = pgm_read_byte(scale2x + (b & 0x0f));
+				d[0] = pgm_read_byte(scale2x + (hi >> 4));
+				d[1] = pgm_read_byte(scale2x + (hi & 0x0f));
+				d[2] = pgm_read_byte(scale2x + (lo >> 4));
+				d[3] = pgm_read_byte(scale2x + (lo & 0x0f));
+			}
+		}
+		e[n] = e[n-1] << lshift;
+		for (k = n-1; k > 0; k--)
+			e[k] = (e[k-1] << lshift) | (e[k] >> rshift);
+		e[0] >>= rshift;
+
+		// repeat the expanded row
+		for (uint8_t r = text_scale; r; r--) {
+			if (y >= display.vres)
+				return;
+			for (k = 0; k < cols; k++)
+				p[k] = (p[k] & ~m[k]) | (e[k] & m[k]);
+			p += display.hres;
+			y++;
+		}
+	}
+}
+
+/*
+ * find the character of the current font for unicode code point cp.
+ * binary search over the runs of the code page map.
+ */
+uint8_t TVout::map_codepoint(uint16_t cp) {
+	uint8_t lo = 0;
+	uint8_t hi = pgm_read_byte(codepage);
+	uint8_t mid;
+	uint16_t first;
+	const unsigned char * run;
+
+	while (lo < hi) {
+		mid = ((uint16_t)lo + hi)/2;
+		run = codepage + 1 + mid*4;
+		first = pgm_read_word(run);
+		if (cp < first)
+			hi = mid;
+		else if (cp - first >= pgm_read_byte(run+2))
+			lo = mid + 1;
+		else
+			return pgm_read_byte(run+3) + (cp - first);
+	}
+	return '?';
 }
 
 void TVout::inc_txtline() {
-	if (cursor_y >= (display.vres - pgm_read_byte(font+1)))
-		shift(pgm_read_byte(font+1),UP);
+	uint8_t h = pgm_read_byte(font+1)*text_scale;
+	if (cursor_y >= (display.vres - h))
+		shift(h,UP);
 	else
-		cursor_y += pgm_read_byte(font+1);
+		cursor_y += h;
 }
 
 /* default implementation: may be overridden */
@@ -60,6 +267,34 @@ void TVout::write(const uint8_t *buffer, uint8_t size)
 }
 
 void TVout::write(uint8_t c) {
+	uint8_t w;
+
+	// UTF-8 decoding, only done when the font has a code page map.
+	// control characters are never mapped
+	if (codepage && c >= ' ') {
+		if (c < 0x80) {
+			utf8_left = 0;
+			if (!map_ascii)
+				c = map_codepoint(c);
+		}
+		else if (c >= 0xC0) {
+			// lead byte, code points beyond 0xFFFF are never mapped
+			utf8_left = 1 + (c >= 0xE0) + (c >= 0xF0);
+			utf8_cp = (c >= 0xF0) ? 0xFFFF : (c & (0x3F >> utf8_left));
+			return;
+		}
+		else {
+			if (!utf8_left)
+				return;
+			if (utf8_cp != 0xFFFF)
+				utf8_cp = (utf8_cp << 6) | (c & 0x3F);
+			if (--utf8_left)
+				return;
+			c = map_codepoint(utf8_cp);
+		}
+	}
+
+	w = (pgm_read_byte(font) & 0x7f)*text_scale;
 	switch(c) {
 		case '\0':			//null
 			break;
@@ -68,8 +303,8 @@ void TVout::write(uint8_t c) {
 			inc_txtline();
 			break;
 		case 8:				//backspace
-			cursor_x -= pgm_read_byte(font);
-			print_char(cursor_x,cursor_y,' ');
+			cursor_x -= w;
+			print_char(cursor_x,cursor_y,codepage ? map_codepoint(' ') : ' ');
 			break;
 		case 13:			//carriage return !?!?!?!VT!?!??!?!
 			cursor_x = 0;
@@ -78,14 +313,14 @@ void TVout::write(uint8_t c) {
 			//clear_screen();
 			break;
 		default:
-			if (cursor_x >= (display.hres*8 - pgm_read_byte(font))) {
+			if (cursor_x >= (display.hres*8 - w)) {
 				cursor_x = 0;
 				inc_txtline();
 				print_char(cursor_x,cursor_y,c);
 			}
 			else
 				print_char(cursor_x,cursor_y,c);
-			cursor_x += pgm_read_byte(font);
+			cursor_x += w;
 	}
 }
 
@@ -328,6 +563,15 @@ void TVout::printNumber(unsigned long n, uint8_t base)
   unsigned char buf[8 * sizeof(long)]; // Assumes 8-bit chars. 
   unsigned long i = 0;
 
+  if (base == 10) {
+    print_dec(n, dec_digits(n));
+    return;
+  }
+  if (base == 16) {
+    print_hex(n, hex_digits(n), 'A');
+    return;
+  }
+
   if (n == 0) {
     print('0');
     return;
@@ -377,4 +621,237 @@ void TVout::printFloat(double number, uint8_t digits)
     print(toPrint);
     remainder -= toPrint; 
   } 
-}
\ No newline at end of file
+}
+
+/*
+ * number of decimal digits needed for n
+ */
+uint8_t TVout::dec_digits(uint32_t n) {
+	uint8_t d = 1;
+	while (d < 10 && n >= pgm_read_dword(powers10 + d))
+		d++;
+	return d;
+}
+
+/*
+ * number of hexadecimal digits needed for n
+ */
+uint8_t TVout::hex_digits(uint32_t n) {
+	uint8_t d = 1;
+	while (d < 8 && (n >> (d*4)))
+		d++;
+	return d;
+}
+
+/*
+ * print the lowest digits decimal digits of n, leading zeros included.
+ * Each digit is found by subtracting its power of ten, no division is done.
+ */
+void TVout::print_dec(uint32_t n, uint8_t digits) {
+	uint32_t p;
+	char c;
+
+	while (--digits) {
+		p = pgm_read_dword(powers10 + digits);
+		c = '0';
+		while (n >= p) {
+			n -= p;
+			c++;
+		}
+		write(c);
+	}
+	write('0' + (uint8_t)n);
+}
+
+/*
+ * print the lowest digits hexadecimal digits of n.
+ * a is the character used for ten, 'a' or 'A'.
+ */
+void TVout::print_hex(uint32_t n, uint8_t digits, char a) {
+	uint8_t d;
+
+	while (digits--) {
+		d = (n >> (digits*4)) & 0x0f;
+		write(d < 10 ? '0' + d : a + d - 10);
+	}
+}
+
+void TVout::print_pad(uint8_t n, char c) {
+	while (n--)
+		write(c);
+}
+
+/* Formatted print with the format string stored in flash.
+ * Text goes straight to the screen, no buffer is used and no floating point
+ * or division code is pulled in.
+ *
+ * Arguments:
+ *	x:
+ *		The x coordinate to start printing at.
+ *	y:
+ *		The y coordinate to start printing at.
+ *	fmt:
+ *		The format string in PROGMEM, use PSTR("...").
+ *		Conversions are %[-][0][width][.precision][l]type where type is:
+ *		d	signed int (long with l)
+ *		u	unsigned int (unsigned long with l)
+ *		x,X	hexadecimal unsigned int (unsigned long with l)
+ *		c	character
+ *		s	string in ram
+ *		S	string in flash, a null string prints (null)
+ *		q	signed fixed point number, 8.8 int (16.16 long with l),
+ *			printed with precision 0-4 fraction digits, default 2
+ *		%	a percent sign
+ *		A '-' aligns the field left, a '0' pads numbers with zeros.
+ */
+void TVout::printfPGM(uint8_t x, uint8_t y, const char fmt[], ...) {
+	va_list ap;
+	char c, pad;
+	uint8_t left, lng, width, prec, len, digits;
+	uint8_t neg;
+	uint32_t n;
+	uint16_t frac;
+	const char * str;
+
+	cursor_x = x;
+	cursor_y = y;
+	va_start(ap, fmt);
+	while ((c = pgm_read_byte(fmt++))) {
+		if (c != '%') {
+			write(c);
+			continue;
+		}
+		left = 0;
+		lng = 0;
+		width = 0;
+		prec = 2;
+		pad = ' ';
+		c = pgm_read_byte(fmt++);
+		if (c == '-') {
+			left = 1;
+			c = pgm_read_byte(fmt++);
+		}
+		if (c == '0') {
+			pad = '0';
+			c = pgm_read_byte(fmt++);
+		}
+		while (c >= '0' && c <= '9') {
+			width = width*10 + c - '0';
+			c = pgm_read_byte(fmt++);
+		}
+		if (c == '.') {
+			prec = 0;
+			c = pgm_read_byte(fmt++);
+			while (c >= '0' && c <= '9') {
+				prec = prec*10 + c - '0';
+				c = pgm_read_byte(fmt++);
+			}
+			if (prec > 4)
+				prec = 4;
+		}
+		if (c == 'l') {
+			lng = 1;
+			c = pgm_read_byte(fmt++);
+		}
+		if (left)
+			pad = ' ';
+
+		neg = 0;
+		frac = 0;
+		switch (c) {
+			case '\0':
+				va_end(ap);
+				return;
+			case 'c':
+			case 's':
+			case 'S':
+				if (c == 'c') {
+					len = 1;
+					str = 0;
+					c = va_arg(ap, int);
+				}
+				else {
+					str = va_arg(ap, const char *);
+					if (!str) {
+						str = null_str;
+						c = 'S';
+					}
+					len = (c == 's') ? strlen(str) : strlen_P(str);
+				}
+				if (!left && width > len)
+					print_pad(width - len, ' ');
+				if (!str)
+					write(c);
+				else if (c == 's')
+					write(str);
+				else
+					printPGM(str);
+				if (left && width > len)
+					print_pad(width - len, ' ');
+				continue;
+			case 'd':
+			case 'q':
+				{
+					long v;
+					if (lng)
+						v = va_arg(ap, long);
+					else if (c == 'q')
+						v = va_arg(ap, int) * 256L;
+					else
+						v = va_arg(ap, int);
+					// negate unsigned, -LONG_MIN does not fit a long
+					n = v;
+					if (v < 0) {
+						neg = 1;
+						n = -n;
+					}
+				}
+				if (c == 'q') {
+					// round in the last digit, then split off the fraction
+					n += pgm_read_word(qround + prec);
+					frac = n;
+					n >>= 16;
+				}
+				digits = dec_digits(n);
+				break;
+			case 'u':
+				n = lng ? va_arg(ap, unsigned long) : va_arg(ap, unsigned int);
+				digits = dec_digits(n);
+				break;
+			case 'x':
+			case 'X':
+				n = lng ? va_arg(ap, unsigned long) : va_arg(ap, unsigned int);
+				digits = hex_digits(n);
+				break;
+			default:
+				write(c);
+				continue;
+		}
+
+		// numbers
+		len = neg + digits;
+		if (c == 'q' && prec)
+			len += prec + 1;
+		if (!left && pad == ' ' && width > len)
+			print_pad(width - len, ' ');
+		if (neg)
+			write('-');
+		if (!left && pad == '0' && width > len)
+			print_pad(width - len, '0');
+		if (c == 'x' || c == 'X')
+			print_hex(n, digits, c - ('x' - 'a'));
+		else
+			print_dec(n, digits);
+		if (c == 'q' && prec) {
+			write('.');
+			while (prec--) {
+				uint32_t f = (uint32_t)frac*10;
+				write('0' + (uint8_t)(f >> 16));
+				frac = f;
+			}
+		}
+		if (left && width > len)
+			print_pad(width - len, ' ');
+	}
+	va_end(ap);
+}
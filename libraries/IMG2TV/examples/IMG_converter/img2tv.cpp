@@ -0,0 +1,1834 @@
+/*
+ * img2tv - native image converter for TVout.
+ *
+ * Does the work of convert_image.sh and NTSC_IMG/img2tvout.sh without a shell
+ * loop per pixel: images are decoded, scaled, dithered and compressed in a few
+ * milliseconds each, spread over all cores.
+ *
+ * Build on the host (Linux, needs libpng):
+ *	g++ -O2 -pthread -o img2tv img2tv.cpp -lpng
+ *
+ * Usage:
+ *	img2tv [options] image...
+ *
+ *	-f rle		RLE compressed images, default. Writes <dir>/<project>.h,
+ *			.cpp, .ino and a .pbm per image, like convert_image.sh
+ *	-f brle		RLE over whole bytes instead of bits, see TVout::rle_bitmap()
+ *	-f lz		LZ77 compressed images for TVout::lz_bitmap()
+ *	-f tile		8x8 tiles shared by all images and a tile map per image
+ *			for TVout::tile_bitmap(), reports the dedupe ratio
+ *	-f bitmap	uncompressed {width, height, rows...} TVout bitmaps,
+ *			one <name>.cpp/.h pair per image, like img2tvout.sh
+ *	-f sheet	one sprite sheet of all frames of all inputs for
+ *			TVout::sprite(), directories are read in name order.
+ *			Writes <dir>/<project>.h/.cpp, default project sprites,
+ *			with a #define per sprite number
+ *	-H x,y|c|b	sprite hotspot, a point of the source image, c for the
+ *			center or b for the bottom center, default 0,0
+ *	-t		trim black borders off sprites, the hotspot stays put
+ *	-f anim		one delta frame animation of all frames of all inputs for
+ *			TVout::anim_begin(), default project animation
+ *	-o dir		output directory, default converted_<project>
+ *	-p project	project name, default images
+ *	-s WxH		target size, default 128x96
+ *	-d method	dithering: fs (Floyd-Steinberg, default), atkinson, bayer
+ *			(ordered 8x8), blue (blue noise) or none (threshold).
+ *			Atkinson and the ordered methods look calmer on a CRT
+ *			and usually compress better than fs
+ *	-D		preview: every dithering method on every image, written
+ *			to <dir>/<name>_<method>.pbm, with the size of each in
+ *			the compressed formats. Nothing else is written
+ *	-g gamma	gamma correction before dithering, default 1, above 1
+ *			brightens the mid tones
+ *	-k contrast	contrast factor around mid grey, default 1
+ *	-i		invert the pixels
+ *	-j n		worker threads, default all cores
+ *	-c		compare, print the compressed size in every format
+ *	-r fps		animation frame rate, default the GIF frame delay or 10
+ *
+ * Inputs are PBM, PGM, PPM (binary and ascii), PNG and GIF, of which only the
+ * first frame is used unless converting an animation. Images larger than the
+ * target are scaled down keeping the aspect ratio. For RLE and animations they
+ * are centered on a black WxH canvas, bitmaps keep their scaled size.
+ *
+ * The output is the same as the scripts: the RLE stream runs over the raw PBM
+ * bits, so set bits are the black pixels of the source, and the byte layout
+ * of the .cpp file is identical. Feeding the .pbm files of a previous run
+ * back in reproduces the same arrays, which can be used as regression check.
+ */
+
+#include <ctype.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <math.h>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <png.h>
+
+// grey scale image, 0 black to 255 white
+struct Image {
+	int w, h;
+	std::vector<uint8_t> px;
+	int delay;	// GIF frame delay in 1/100 s, 0 when not known
+};
+
+enum Dither { DITHER_NONE, DITHER_FS, DITHER_ATKINSON, DITHER_BAYER, DITHER_BLUE };
+
+static const char * dither_names[] = { "none", "fs", "atkinson", "bayer", "blue" };
+
+enum Format { FORMAT_RLE, FORMAT_BRLE, FORMAT_LZ, FORMAT_TILE, FORMAT_BITMAP, FORMAT_SHEET, FORMAT_ANIM };
+
+static const char * format_names[] = { "rle", "brle", "lz", "tile", "bitmap", "sheet", "anim" };
+
+struct Options {
+	Format format;
+	int width, height;
+	Dither dither;
+	double gamma;	// applied before dithering, above 1 brightens the mid tones
+	double contrast;	// factor around mid grey
+	bool invert;
+	bool compare;
+	int fps;	// animation frame rate, 0 to take it from the GIF
+	std::string hotspot;	// sprite hotspot, "x,y", "c" or "b"
+	bool trim;	// crop black borders off sprites
+};
+
+struct Result {
+	std::string name;
+	std::string error;
+	int w, h;
+	std::vector<uint8_t> bits;	// packed rows, MSB left, PBM polarity
+	std::vector<uint8_t> data;	// compressed
+	size_t sizes[FORMAT_BITMAP];	// compressed size in every format, with -c
+	double ms;
+};
+
+static bool read_file(const char * path, std::string & out) {
+	FILE * f = fopen(path, "rb");
+	if (!f)
+		return false;
+	char buf[65536];
+	size_t n;
+	out.clear();
+	while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+		out.append(buf, n);
+	fclose(f);
+	return true;
+}
+
+/*
+ * PNM header field, skipping white space and comments.
+ */
+static int pnm_field(const std::string & d, size_t & i) {
+	int v = 0;
+	for (;;) {
+		while (i < d.size() && isspace((unsigned char)d[i]))
+			i++;
+		if (i < d.size() && d[i] == '#') {
+			while (i < d.size() && d[i] != '\n')
+				i++;
+			continue;
+		}
+		break;
+	}
+	if (i >= d.size() || !isdigit((unsigned char)d[i]))
+		return -1;
+	while (i < d.size() && isdigit((unsigned char)d[i]))
+		v = v*10 + (d[i++] - '0');
+	return v;
+}
+
+static bool load_pnm(const std::string & d, Image & img, std::string & err) {
+	int type = d[1] - '0';
+	size_t i = 2;
+	int maxval = 1;
+
+	img.w = pnm_field(d, i);
+	img.h = pnm_field(d, i);
+	if (type != 1 && type != 4)
+		maxval = pnm_field(d, i);
+	if (img.w <= 0 || img.h <= 0 || maxval <= 0 || maxval > 65535) {
+		err = "bad PNM header";
+		return false;
+	}
+	i++;	// single white space before binary data
+
+	int ch = (type == 3 || type == 6) ? 3 : 1;
+	int bps = maxval > 255 ? 2 : 1;
+	size_t n = (size_t)img.w*img.h;
+	img.px.resize(n);
+
+	if (type == 4) {
+		size_t stride = (img.w + 7)/8;
+		if (d.size() < i + stride*img.h) {
+			err = "truncated PBM";
+			return false;
+		}
+		for (int y = 0; y < img.h; y++)
+			for (int x = 0; x < img.w; x++)
+				img.px[(size_t)y*img.w + x] = (d[i + y*stride + x/8] >> (7 - (x & 7)) & 1) ? 0 : 255;
+		return true;
+	}
+
+	std::vector<int> s(n*ch);
+	if (type >= 4) {
+		if (d.size() < i + s.size()*bps) {
+			err = "truncated PNM";
+			return false;
+		}
+		for (size_t k = 0; k < s.size(); k++)
+			s[k] = bps == 2 ? ((uint8_t)d[i + 2*k] << 8) | (uint8_t)d[i + 2*k + 1] : (uint8_t)d[i + k];
+	}
+	else {
+		i--;
+		for (size_t k = 0; k < s.size(); k++) {
+			if (type == 1) {
+				while (i < d.size() && d[i] != '0' && d[i] != '1')
+					i++;
+				s[k] = i < d.size() ? d[i++] - '0' : -1;
+			}
+			else
+				s[k] = pnm_field(d, i);
+			if (s[k] < 0) {
+				err = "truncated PNM";
+				return false;
+			}
+		}
+	}
+
+	for (size_t k = 0; k < n; k++) {
+		int v;
+		if (type == 1)
+			v = s[k] ? 0 : 255;
+		else if (ch == 3)
+			v = (s[3*k]*54 + s[3*k+1]*183 + s[3*k+2]*19)*255/(256*maxval);
+		else
+			v = s[k]*255/maxval;
+		img.px[k] = v;
+	}
+	return true;
+}
+
+/*
+ * PNG through the simplified libpng API, transparent pixels go on black.
+ */
+static bool load_png(const std::string & d, Image & img, std::string & err) {
+	png_image png;
+	memset(&png, 0, sizeof(png));
+	png.version = PNG_IMAGE_VERSION;
+	if (!png_image_begin_read_from_memory(&png, d.data(), d.size())) {
+		err = png.message;
+		return false;
+	}
+	png.format = PNG_FORMAT_GA;
+	std::vector<uint8_t> ga(PNG_IMAGE_SIZE(png));
+	if (!png_image_finish_read(&png, 0, ga.data(), 0, 0)) {
+		err = png.message;
+		png_image_free(&png);
+		return false;
+	}
+	img.w = png.width;
+	img.h = png.height;
+	img.px.resize((size_t)img.w*img.h);
+	for (size_t k = 0; k < img.px.size(); k++)
+		img.px[k] = ga[2*k]*ga[2*k+1]/255;
+	return true;
+}
+
+/*
+ * GIF, every frame composed onto the logical screen as a viewer shows it.
+ * Transparent areas and disposed frames go to black.
+ */
+struct GifReader {
+	const uint8_t * d;
+	size_t size, pos;
+
+	int byte() {
+		return pos < size ? d[pos++] : -1;
+	}
+	int word() {
+		int lo = byte();
+		return lo | byte() << 8;
+	}
+	// concatenated data sub-blocks
+	std::string blocks() {
+		std::string out;
+		int n;
+		while ((n = byte()) > 0 && pos + n <= size) {
+			out.append((const char *)d + pos, n);
+			pos += n;
+		}
+		return out;
+	}
+};
+
+static bool lzw_decode(const std::string & in, int min_size, size_t count, std::vector<uint8_t> & out) {
+	int clear = 1 << min_size, size = min_size + 1, next = clear + 2;
+	std::vector<uint16_t> prefix(4096);
+	std::vector<uint8_t> suffix(4096), stack(4097);
+	int prev = -1, first = 0;
+	uint32_t acc = 0;
+	int bits = 0;
+
+	out.clear();
+	for (size_t i = 0; out.size() < count; ) {
+		while (bits < size && i < in.size()) {
+			acc |= (uint32_t)(uint8_t)in[i++] << bits;
+			bits += 8;
+		}
+		if (bits < size)
+			break;
+		int code = acc & ((1 << size) - 1);
+		acc >>= size;
+		bits -= size;
+
+		if (code == clear) {
+			size = min_size + 1;
+			next = clear + 2;
+			prev = -1;
+			continue;
+		}
+		if (code == clear + 1)
+			break;
+		if (prev < 0) {
+			if (code >= clear)
+				return false;
+			out.push_back(code);
+			prev = first = code;
+			continue;
+		}
+		int c = code, sp = 0;
+		if (code >= next) {
+			if (code > next)
+				return false;
+			stack[sp++] = first;
+			c = prev;
+		}
+		while (c >= clear) {
+			stack[sp++] = suffix[c];
+			c = prefix[c];
+		}
+		stack[sp++] = first = c;
+		while (sp)
+			out.push_back(stack[--sp]);
+		if (next < 4096) {
+			prefix[next] = prev;
+			suffix[next] = first;
+			if (++next == 1 << size && size < 12)
+				size++;
+		}
+		prev = code;
+	}
+	out.resize(count, 0);
+	return true;
+}
+
+static bool load_gif(const std::string & data, std::vector<Image> & frames, std::string & err) {
+	GifReader g = { (const uint8_t *)data.data(), data.size(), 6 };
+	uint8_t global[768], local[768];
+	int w = g.word(), h = g.word();
+	int flags = g.byte();
+	int disposal = 0, transparent = -1, delay = 0;
+
+	g.byte();	// background, shown as black
+	g.byte();
+	if (w <= 0 || h <= 0) {
+		err = "bad GIF header";
+		return false;
+	}
+	int ncolors = 0;
+	if (flags & 0x80) {
+		ncolors = 2 << (flags & 7);
+		for (int i = 0; i < ncolors*3; i++)
+			global[i] = g.byte();
+	}
+
+	std::vector<uint8_t> canvas((size_t)w*h, 0), saved;
+	for (;;) {
+		int b = g.byte();
+		if (b == 0x21) {
+			int label = g.byte();
+			std::string ext = g.blocks();
+			if (label == 0xF9 && ext.size() >= 4) {
+				disposal = (uint8_t)ext[0] >> 2 & 7;
+				delay = (uint8_t)ext[1] | (uint8_t)ext[2] << 8;
+				transparent = (ext[0] & 1) ? (uint8_t)ext[3] : -1;
+			}
+			continue;
+		}
+		if (b != 0x2C)
+			break;
+
+		int fx = g.word(), fy = g.word(), fw = g.word(), fh = g.word();
+		int fflags = g.byte();
+		const uint8_t * pal = global;
+		int n = ncolors;
+		if (fflags & 0x80) {
+			n = 2 << (fflags & 7);
+			for (int i = 0; i < n*3; i++)
+				local[i] = g.byte();
+			pal = local;
+		}
+		int min_size = g.byte();
+		std::vector<uint8_t> idx;
+		if (min_size < 1 || min_size > 11 || !lzw_decode(g.blocks(), min_size, (size_t)fw*fh, idx)) {
+			err = "bad GIF image data";
+			return false;
+		}
+
+		if (disposal == 3)
+			saved = canvas;
+		// interlaced frames store rows 0,8,.. then 4,12,.. then 2,6,.. then 1,3,..
+		std::vector<int> rows;
+		if (fflags & 0x40) {
+			static const int start[] = { 0, 4, 2, 1 }, step[] = { 8, 8, 4, 2 };
+			for (int p = 0; p < 4; p++)
+				for (int y = start[p]; y < fh; y += step[p])
+					rows.push_back(y);
+		}
+		else
+			for (int y = 0; y < fh; y++)
+				rows.push_back(y);
+		for (int r = 0; r < fh; r++) {
+			int cy = fy + rows[r];
+			for (int x = 0; x < fw; x++) {
+				int cx = fx + x, c = idx[(size_t)r*fw + x];
+				if (cx >= w || cy >= h || c == transparent || c >= n)
+					continue;
+				canvas[(size_t)cy*w + cx] = (pal[3*c]*54 + pal[3*c+1]*183 + pal[3*c+2]*19)/256;
+			}
+		}
+
+		Image img;
+		img.w = w;
+		img.h = h;
+		img.px = canvas;
+		img.delay = delay;
+		frames.push_back(img);
+
+		if (disposal == 2) {
+			for (int y = fy; y < fy + fh && y < h; y++)
+				for (int x = fx; x < fx + fw && x < w; x++)
+					canvas[(size_t)y*w + x] = 0;
+		}
+		else if (disposal == 3)
+			canvas = saved;
+		disposal = 0;
+		transparent = -1;
+		delay = 0;
+	}
+	if (frames.empty()) {
+		err = "GIF without images";
+		return false;
+	}
+	return true;
+}
+
+/*
+ * load all frames of an image, only GIF has more than one
+ */
+static bool load_image(const char * path, std::vector<Image> & frames, std::string & err) {
+	std::string d;
+	Image img;
+
+	img.delay = 0;
+	if (!read_file(path, d)) {
+		err = "cannot read file";
+		return false;
+	}
+	if (d.size() > 6 && (!memcmp(d.data(), "GIF87a", 6) || !memcmp(d.data(), "GIF89a", 6)))
+		return load_gif(d, frames, err);
+	if (d.size() > 2 && d[0] == 'P' && d[1] >= '1' && d[1] <= '6') {
+		if (!load_pnm(d, img, err))
+			return false;
+	}
+	else if (d.size() > 8 && !memcmp(d.data(), "\x89PNG", 4)) {
+		if (!load_png(d, img, err))
+			return false;
+	}
+	else {
+		err = "unsupported format, use PBM/PGM/PPM, PNG or GIF";
+		return false;
+	}
+	frames.push_back(img);
+	return true;
+}
+
+/*
+ * scale down by area averaging, every source pixel adds to the target pixels
+ * it covers in proportion to the overlap. Weights are in 1/256 pixel.
+ */
+static void shrink(const Image & in, int w, int h, Image & out) {
+	out.w = w;
+	out.h = h;
+	out.px.assign((size_t)w*h, 0);
+
+	// coverage of the source columns and rows by target columns and rows
+	struct Span { int first; std::vector<uint32_t> wt; };
+	auto spans = [](int from, int to) {
+		std::vector<Span> s(to);
+		for (int t = 0; t < to; t++) {
+			// target pixel t covers source range [t*from/to, (t+1)*from/to)
+			uint64_t a = (uint64_t)t*from*256/to, b = (uint64_t)(t+1)*from*256/to;
+			s[t].first = a/256;
+			for (uint64_t p = a/256*256; p < b; p += 256) {
+				uint64_t lo = p > a ? p : a, hi = p + 256 < b ? p + 256 : b;
+				s[t].wt.push_back(hi - lo);
+			}
+		}
+		return s;
+	};
+	std::vector<Span> sx = spans(in.w, w), sy = spans(in.h, h);
+
+	for (int y = 0; y < h; y++) {
+		for (int x = 0; x < w; x++) {
+			uint64_t sum = 0, area = 0;
+			for (size_t j = 0; j < sy[y].wt.size(); j++) {
+				const uint8_t * row = &in.px[(size_t)(sy[y].first + j)*in.w + sx[x].first];
+				for (size_t i = 0; i < sx[x].wt.size(); i++) {
+					uint64_t a = (uint64_t)sy[y].wt[j]*sx[x].wt[i];
+					sum += a*row[i];
+					area += a;
+				}
+			}
+			out.px[(size_t)y*w + x] = (sum + area/2)/area;
+		}
+	}
+}
+
+/*
+ * fit into w x h keeping the aspect ratio, only ever scaling down.
+ * With extent the result is centered on a black w x h canvas.
+ */
+static void fit(Image & img, int w, int h, bool extent) {
+	if (img.w > w || img.h > h) {
+		int nw, nh;
+		if ((int64_t)img.w*h > (int64_t)img.h*w) {
+			nw = w;
+			nh = ((int64_t)img.h*w*2 + img.w)/(2*img.w);
+		}
+		else {
+			nh = h;
+			nw = ((int64_t)img.w*h*2 + img.h)/(2*img.h);
+		}
+		Image s;
+		shrink(img, nw ? nw : 1, nh ? nh : 1, s);
+		img = std::move(s);
+	}
+	if (extent && (img.w != w || img.h != h)) {
+		Image c;
+		c.w = w;
+		c.h = h;
+		c.px.assign((size_t)w*h, 0);
+		int ox = (w - img.w)/2, oy = (h - img.h)/2;
+		for (int y = 0; y < img.h; y++)
+			for (int x = 0; x < img.w; x++) {
+				int cx = x + ox, cy = y + oy;
+				if (cx >= 0 && cx < w && cy >= 0 && cy < h)
+					c.px[(size_t)cy*w + cx] = img.px[(size_t)y*img.w + x];
+			}
+		img = std::move(c);
+	}
+}
+
+/*
+ * gamma and contrast, in place
+ */
+static void adjust(Image & img, const Options & opt) {
+	if (opt.gamma == 1 && opt.contrast == 1)
+		return;
+	uint8_t lut[256];
+	for (int v = 0; v < 256; v++) {
+		double g = (pow(v/255.0, 1/opt.gamma) - 0.5)*opt.contrast + 0.5;
+		lut[v] = g <= 0 ? 0 : g >= 1 ? 255 : (int)(g*255 + 0.5);
+	}
+	for (size_t i = 0; i < img.px.size(); i++)
+		img.px[i] = lut[img.px[i]];
+}
+
+/*
+ * 64x64 blue noise threshold map by void and cluster (Ulichney 1993), the
+ * rank 0-4095 of every pixel. Built once, on first use.
+ */
+static const std::vector<uint16_t> & blue_noise() {
+	static const std::vector<uint16_t> rank = []() {
+		const int N = 64, M = N*N;
+		std::vector<double> g(M), energy(M, 0);
+		std::vector<uint8_t> on(M, 0), start;
+		std::vector<uint16_t> r(M);
+		uint32_t seed = 1;
+
+		for (int y = 0; y < N; y++)
+			for (int x = 0; x < N; x++) {
+				int dx = std::min(x, N - x), dy = std::min(y, N - y);
+				g[y*N + x] = exp(-(dx*dx + dy*dy)/(2*1.5*1.5));
+			}
+		// the gaussian is negligible beyond 9 pixels
+		auto toggle = [&](int p) {
+			double s = on[p] ? -1 : 1;
+			on[p] ^= 1;
+			for (int dy = -9; dy <= 9; dy++)
+				for (int dx = -9; dx <= 9; dx++)
+					energy[((p/N + dy) & (N - 1))*N + ((p%N + dx) & (N - 1))] += s*g[(dy & (N - 1))*N + (dx & (N - 1))];
+		};
+		// tightest cluster among the set pixels, largest void among the others
+		auto find = [&](bool cluster) {
+			int best = -1;
+			for (int p = 0; p < M; p++)
+				if (on[p] == cluster && (best < 0 || (cluster ? energy[p] > energy[best] : energy[p] < energy[best])))
+					best = p;
+			return best;
+		};
+
+		// a random tenth of the pixels, spread out evenly
+		int ones = 0;
+		while (ones < M/10) {
+			seed = seed*1103515245 + 12345;
+			int p = seed >> 8 & (M - 1);
+			if (!on[p]) {
+				toggle(p);
+				ones++;
+			}
+		}
+		for (;;) {
+			int c = find(true);
+			toggle(c);
+			int v = find(false);
+			toggle(v);
+			if (v == c)
+				break;
+		}
+		start = on;
+		std::vector<double> start_energy = energy;
+
+		for (int k = ones - 1; k >= 0; k--) {
+			int c = find(true);
+			toggle(c);
+			r[c] = k;
+		}
+		on = start;
+		energy = start_energy;
+		for (int k = ones; k < M; k++) {
+			int v = find(false);
+			toggle(v);
+			r[v] = k;
+		}
+		return r;
+	}();
+	return rank;
+}
+
+/*
+ * reduce to one bit per pixel. The result uses the PBM convention, set bits
+ * are black. The error diffusion runs serpentine with errors in 1/16 levels:
+ * Floyd-Steinberg passes on all of the error, Atkinson 6/8 of it to a wider
+ * neighbourhood, which keeps highlights and shadows clean and leaves longer
+ * runs for the compressors. Ordered dithering compares with a threshold map,
+ * the 8x8 Bayer matrix or 64x64 blue noise, and has no error to carry.
+ */
+static void dither(const Image & img, Dither method, std::vector<uint8_t> & bits) {
+	static const uint8_t bayer[8][8] = {
+		{  0, 32,  8, 40,  2, 34, 10, 42 },
+		{ 48, 16, 56, 24, 50, 18, 58, 26 },
+		{ 12, 44,  4, 36, 14, 46,  6, 38 },
+		{ 60, 28, 52, 20, 62, 30, 54, 22 },
+		{  3, 35, 11, 43,  1, 33,  9, 41 },
+		{ 51, 19, 59, 27, 49, 17, 57, 25 },
+		{ 15, 47,  7, 39, 13, 45,  5, 37 },
+		{ 63, 31, 55, 23, 61, 29, 53, 21 }
+	};
+	const uint16_t * blue = method == DITHER_BLUE ? blue_noise().data() : 0;
+	int stride = (img.w + 7)/8;
+	std::vector<int> cur(img.w + 4), next(img.w + 4), after(img.w + 4);
+
+	bits.assign((size_t)stride*img.h, 0);
+	for (int y = 0; y < img.h; y++) {
+		const uint8_t * row = &img.px[(size_t)y*img.w];
+		bool rev = y & 1;
+		std::fill(after.begin(), after.end(), 0);
+		for (int i = 0; i < img.w; i++) {
+			int x = rev ? img.w - 1 - i : i;
+			int v = row[x], t = 128;
+			if (method == DITHER_FS || method == DITHER_ATKINSON)
+				v += cur[x + 2]/16;
+			else if (method == DITHER_BAYER)
+				t = (bayer[y & 7][x & 7]*2 + 1)*255/128 + 1;
+			else if (method == DITHER_BLUE)
+				t = (blue[(y & 63)*64 + (x & 63)]*2 + 1)*255/8192 + 1;
+			int out = v >= t ? 255 : 0;
+			if (!out)
+				bits[(size_t)y*stride + x/8] |= 0x80 >> (x & 7);
+			int e = v - out, d = rev ? -1 : 1;
+			if (method == DITHER_FS) {
+				cur[x + 2 + d] += e*7;
+				next[x + 2 - d] += e*3;
+				next[x + 2] += e*5;
+				next[x + 2 + d] += e;
+			}
+			else if (method == DITHER_ATKINSON) {
+				cur[x + 2 + d] += e*2;
+				cur[x + 2 + 2*d] += e*2;
+				next[x + 2 - d] += e*2;
+				next[x + 2] += e*2;
+				next[x + 2 + d] += e*2;
+				after[x + 2] += e*2;
+			}
+		}
+		cur.swap(next);
+		next.swap(after);
+	}
+}
+
+/*
+ * bitwise RLE as written by convert_image.sh: one byte per run, the pixel
+ * value in bit 7 and the run length 1-127 in the low bits. Runs continue
+ * across rows.
+ */
+static void rle_encode(const std::vector<uint8_t> & bits, std::vector<uint8_t> & out) {
+	int run = 0, val = 0;
+
+	out.clear();
+	for (size_t i = 0; i < bits.size(); i++) {
+		for (int b = 7; b >= 0; b--) {
+			int p = bits[i] >> b & 1;
+			if (run && p != val) {
+				out.push_back(run | val << 7);
+				run = 0;
+			}
+			val = p;
+			if (++run == 127) {
+				out.push_back(run | val << 7);
+				run = 0;
+			}
+		}
+	}
+	if (run)
+		out.push_back(run | val << 7);
+}
+
+/*
+ * byte runs: a byte n below 128 is followed by n+1 literal bytes, from 128 up
+ * by a byte repeated n-126 times. Runs of two only pay off when they do not
+ * interrupt a literal.
+ */
+static void rle_encode_bytes(const std::vector<uint8_t> & bits, std::vector<uint8_t> & out) {
+	size_t n = bits.size(), i = 0;
+	long lit = -1;	// index of the open literal's count byte
+
+	out.clear();
+	while (i < n) {
+		size_t r = 1;
+		while (i + r < n && r < 129 && bits[i + r] == bits[i])
+			r++;
+		if (r >= 3 || (r == 2 && lit < 0)) {
+			out.push_back(r + 126);
+			out.push_back(bits[i]);
+			i += r;
+			continue;
+		}
+		if (lit < 0) {
+			lit = out.size();
+			out.push_back(0xFF);
+		}
+		out.push_back(bits[i++]);
+		if (++out[lit] == 127 || i == n ||
+			(i + 2 < n && bits[i] == bits[i+1] && bits[i] == bits[i+2]))
+			lit = -1;
+	}
+}
+
+/*
+ * LZ77 for TVout::lz_bitmap(). Control bits are collected MSB first in bytes
+ * that are interleaved with the data: a control byte is put in the stream
+ * where the decoder runs out of bits, literals stay whole bytes.
+ *	0		literal, the next stream byte
+ *	1 len off	match, len-1 Elias gamma coded (len >= 2), then
+ *			0 and 6 bits of offset-1, or 1 and 11 bits of offset-1
+ * The window is everything decoded so far, up to 2048 bytes back. The parse
+ * is optimal in size, found backwards over the bit costs.
+ */
+struct BitWriter {
+	std::vector<uint8_t> & out;
+	size_t ctrl;
+	uint8_t mask;
+
+	BitWriter(std::vector<uint8_t> & o) : out(o), ctrl(0), mask(0) {}
+	void bit(int b) {
+		if (!mask) {
+			ctrl = out.size();
+			out.push_back(0);
+			mask = 0x80;
+		}
+		if (b)
+			out[ctrl] |= mask;
+		mask >>= 1;
+	}
+	void bits(unsigned v, int n) {
+		while (n--)
+			bit(v >> n & 1);
+	}
+	void gamma(unsigned v) {
+		int n = 0;
+		while (v >> (n + 1))
+			n++;
+		bits(0, n);
+		bits(v, n + 1);
+	}
+};
+
+static int gamma_bits(unsigned v) {
+	int n = 0;
+	while (v >> (n + 1))
+		n++;
+	return 2*n + 1;
+}
+
+static void lz_encode(const std::vector<uint8_t> & data, std::vector<uint8_t> & out) {
+	const int short_bits = 6, long_bits = 11;
+	int n = data.size();
+	std::vector<int> cost(n + 1, 0), len(n + 1, 0), off(n + 1, 0);
+
+	for (int i = n - 1; i >= 0; i--) {
+		cost[i] = 9 + cost[i + 1];
+		len[i] = 1;
+		for (int o = 1; o <= (1 << long_bits) && o <= i; o++) {
+			int oc = o <= (1 << short_bits) ? 1 + short_bits : 1 + long_bits;
+			for (int l = 0; i + l < n && data[i + l] == data[i + l - o]; ) {
+				if (++l < 2)
+					continue;
+				int c = 1 + gamma_bits(l - 1) + oc + cost[i + l];
+				if (c < cost[i]) {
+					cost[i] = c;
+					len[i] = l;
+					off[i] = o;
+				}
+			}
+		}
+	}
+
+	out.clear();
+	BitWriter w(out);
+	for (int i = 0; i < n; i += len[i]) {
+		if (len[i] == 1) {
+			w.bit(0);
+			out.push_back(data[i]);
+			continue;
+		}
+		w.bit(1);
+		w.gamma(len[i] - 1);
+		if (off[i] <= (1 << short_bits)) {
+			w.bit(0);
+			w.bits(off[i] - 1, short_bits);
+		}
+		else {
+			w.bit(1);
+			w.bits(off[i] - 1, long_bits);
+		}
+	}
+}
+
+/*
+ * array name the scripts derive from a file name: up to the first dot,
+ * everything but letters, digits and '_' replaced, no leading digit.
+ */
+/*
+ * Tiles for TVout::tile_bitmap(): the image is cut into 8x8 tiles, each one
+ * is looked up in the bank and only added when it is new. The map is
+ * {width, height} in tiles and a bank index per tile. Returns false when the
+ * bank would grow past the 256 tiles a byte can index, leaving it unchanged.
+ */
+struct TileBank {
+	std::vector<uint64_t> tiles;	// 8 rows, top row in the high byte
+	std::unordered_map<uint64_t, int> index;
+};
+
+static bool tile_encode(const std::vector<uint8_t> & bits, int wb, int h,
+		TileBank & bank, std::vector<uint8_t> & map) {
+	size_t start = bank.tiles.size();
+
+	map.clear();
+	map.push_back(wb);
+	map.push_back(h/8);
+	for (int ty = 0; ty < h/8; ty++)
+		for (int tx = 0; tx < wb; tx++) {
+			uint64_t t = 0;
+			for (int r = 0; r < 8; r++)
+				t = t << 8 | bits[(size_t)(ty*8 + r)*wb + tx];
+			auto it = bank.index.find(t);
+			if (it == bank.index.end()) {
+				if (bank.tiles.size() == 256) {
+					for (size_t k = start; k < bank.tiles.size(); k++)
+						bank.index.erase(bank.tiles[k]);
+					bank.tiles.resize(start);
+					return false;
+				}
+				it = bank.index.emplace(t, bank.tiles.size()).first;
+				bank.tiles.push_back(t);
+			}
+			map.push_back(it->second);
+		}
+	return true;
+}
+
+static std::string array_name(const char * path) {
+	const char * s = strrchr(path, '/');
+	std::string n = s ? s + 1 : path;
+	n = n.substr(0, n.find('.'));
+	for (size_t i = 0; i < n.size(); i++)
+		if (!isalnum((unsigned char)n[i]) && n[i] != '_')
+			n[i] = '_';
+	if (!n.empty() && isdigit((unsigned char)n[0]))
+		n = "_" + n;
+	return n.empty() ? "image_data" : n;
+}
+
+/*
+ * bits in one of the compressed formats, false if the image cannot be tiled
+ */
+static bool encode(Format f, const std::vector<uint8_t> & bits, int w, int h, std::vector<uint8_t> & out) {
+	if (f == FORMAT_RLE)
+		rle_encode(bits, out);
+	else if (f == FORMAT_BRLE)
+		rle_encode_bytes(bits, out);
+	else if (f == FORMAT_LZ)
+		lz_encode(bits, out);
+	else {
+		// on its own, the tiles shared with other images are counted by write_tiles()
+		TileBank bank;
+		if (w % 8 || h % 8 || !tile_encode(bits, w/8, h, bank, out))
+			return false;
+		for (size_t k = 0; k < bank.tiles.size(); k++)
+			for (int b = 56; b >= 0; b -= 8)
+				out.push_back(bank.tiles[k] >> b);
+	}
+	return true;
+}
+
+static void convert(const char * path, const Options & opt, Result & r) {
+	auto t0 = std::chrono::steady_clock::now();
+	std::vector<Image> frames;
+
+	r.name = array_name(path);
+	if (!load_image(path, frames, r.error))
+		return;
+	Image & img = frames[0];
+	fit(img, opt.width, opt.height, opt.format != FORMAT_BITMAP);
+	adjust(img, opt);
+	dither(img, opt.dither, r.bits);
+	if (opt.invert)
+		for (size_t i = 0; i < r.bits.size(); i++)
+			r.bits[i] = ~r.bits[i];
+	r.w = img.w;
+	r.h = img.h;
+	for (int f = 0; f < FORMAT_BITMAP; f++) {
+		if (f != opt.format && !opt.compare)
+			continue;
+		std::vector<uint8_t> out;
+		if (!encode((Format)f, r.bits, r.w, r.h, out)) {
+			if (f == opt.format)
+				r.error = "needs a size in multiples of 8 and at most 256 different tiles";
+			continue;
+		}
+		r.sizes[f] = out.size();
+		if (f == opt.format)
+			r.data.swap(out);
+	}
+	r.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+/*
+ * Delta record turning frame a into frame b for TVout::anim_update(), XOR
+ * spans {row, byte column, length, bytes} ended by 0xFF. Gaps of up to two
+ * unchanged bytes are cheaper to carry along than a new span header.
+ */
+static void anim_delta(const std::vector<uint8_t> & a, const std::vector<uint8_t> & b,
+		int wb, int h, std::vector<uint8_t> & out) {
+	for (int y = 0; y < h; y++) {
+		const uint8_t * pa = &a[(size_t)y*wb], * pb = &b[(size_t)y*wb];
+		for (int x = 0; x < wb; ) {
+			if (pa[x] == pb[x]) {
+				x++;
+				continue;
+			}
+			int end = x + 1, last = x;
+			while (end < wb && end - x < 255 && end - last <= 3) {
+				if (pa[end] != pb[end])
+					last = end;
+				end++;
+			}
+			out.push_back(y);
+			out.push_back(x);
+			out.push_back(last + 1 - x);
+			for (int k = x; k <= last; k++)
+				out.push_back(pa[k] ^ pb[k]);
+			x = last + 1;
+		}
+	}
+	out.push_back(0xFF);
+}
+
+/*
+ * Runs fn(0..count-1) on up to jobs threads, returns the threads used.
+ */
+static int parallel_for(int jobs, int count, const std::function<void(int)> & fn) {
+	std::atomic<int> next(0);
+	std::vector<std::thread> pool;
+	for (int t = 0; t < jobs && t < count; t++)
+		pool.emplace_back([&]() {
+			for (int k; (k = next++) < count; )
+				fn(k);
+		});
+	for (size_t t = 0; t < pool.size(); t++)
+		pool[t].join();
+	return pool.size();
+}
+
+// the sketch convert_image.sh writes along with the images
+static const char ino_template[] = R"INO(
+#include <TVout.h>
+#include <avr/pgmspace.h> // For pgm_read_byte, pgm_read_word_near
+
+TVout TV;
+
+#include "@PROJECT@.h"
+
+// Array of pointers to compressed images (in Flash)
+const unsigned char * const image_list_compressed[] PROGMEM = {
+@LIST@
+};@TABLES@
+
+// Number of images (in Flash)
+const int num_images PROGMEM = @COUNT@;
+
+
+// --- Melody ---
+#define NOTE_E5  659
+#define NOTE_F5  698
+#define NOTE_G5  784
+#define NOTE_A5  880
+#define NOTE_B5  988
+#define NOTE_C6 1047
+#define NOTE_D6 1175
+#define NOTE_E6 1319
+
+// Melody in Flash (doubled length), 120 ms per note and a short pause.
+// TV.play() runs it in the background, loop() stays free meanwhile.
+#define N(f) SONG_NOTE(f, 120), SONG_REST(20)
+PROGMEM const unsigned int melody[] = {
+  N(NOTE_E5), N(NOTE_F5), N(NOTE_G5), N(NOTE_A5), N(NOTE_A5), N(NOTE_G5), N(NOTE_F5), N(NOTE_E5),
+  N(NOTE_G5), N(NOTE_A5), N(NOTE_B5), N(NOTE_C6), N(NOTE_C6), N(NOTE_B5), N(NOTE_A5), N(NOTE_G5),
+  N(NOTE_A5), N(NOTE_B5), N(NOTE_C6), N(NOTE_D6), N(NOTE_D6), N(NOTE_C6), N(NOTE_B5), N(NOTE_A5),
+  N(NOTE_B5), N(NOTE_C6), N(NOTE_D6), N(NOTE_E6), N(NOTE_E6), N(NOTE_D6), N(NOTE_C6), N(NOTE_B5),
+  N(NOTE_E5), N(NOTE_F5), N(NOTE_G5), N(NOTE_A5), N(NOTE_A5), N(NOTE_G5), N(NOTE_F5), N(NOTE_E5),
+  N(NOTE_G5), N(NOTE_A5), N(NOTE_B5), N(NOTE_C6), N(NOTE_C6), N(NOTE_B5), N(NOTE_A5), N(NOTE_G5),
+  N(NOTE_A5), N(NOTE_B5), N(NOTE_C6), N(NOTE_D6), N(NOTE_D6), N(NOTE_C6), N(NOTE_B5), N(NOTE_A5),
+  N(NOTE_B5), N(NOTE_A5), N(NOTE_G5), N(NOTE_F5), N(NOTE_E5), N(NOTE_D6), N(NOTE_C6), N(NOTE_B5),
+  // Repeat melody for increased duration
+  N(NOTE_E5), N(NOTE_F5), N(NOTE_G5), N(NOTE_A5), N(NOTE_A5), N(NOTE_G5), N(NOTE_F5), N(NOTE_E5),
+  N(NOTE_G5), N(NOTE_A5), N(NOTE_B5), N(NOTE_C6), N(NOTE_C6), N(NOTE_B5), N(NOTE_A5), N(NOTE_G5),
+  N(NOTE_A5), N(NOTE_B5), N(NOTE_C6), N(NOTE_D6), N(NOTE_D6), N(NOTE_C6), N(NOTE_B5), N(NOTE_A5),
+  N(NOTE_B5), N(NOTE_C6), N(NOTE_D6), N(NOTE_E6), N(NOTE_E6), N(NOTE_D6), N(NOTE_C6), N(NOTE_B5),
+  N(NOTE_E5), N(NOTE_F5), N(NOTE_G5), N(NOTE_A5), N(NOTE_A5), N(NOTE_G5), N(NOTE_F5), N(NOTE_E5),
+  N(NOTE_G5), N(NOTE_A5), N(NOTE_B5), N(NOTE_C6), N(NOTE_C6), N(NOTE_B5), N(NOTE_A5), N(NOTE_G5),
+  N(NOTE_A5), N(NOTE_B5), N(NOTE_C6), N(NOTE_D6), N(NOTE_D6), N(NOTE_C6), N(NOTE_B5), N(NOTE_A5),
+  N(NOTE_B5), N(NOTE_A5), N(NOTE_G5), N(NOTE_F5), N(NOTE_E5), N(NOTE_D6), N(NOTE_C6), N(NOTE_B5),
+  // Delay before the next image
+  SONG_REST(1000),
+  SONG_END
+};
+
+void setup() {
+  // Initialize TVout with target resolution
+  TV.begin(NTSC, @W@, @H@);
+  // TV.begin(PAL, @W@, @H@); // For PAL region
+
+  // --- Adjust horizontal offset ---
+  // Default value can be around 10-15.
+  // Try starting with 10 or 12 and increase/decrease
+  // until the image is centered. 14 is a starting value.
+  TV.force_outstart(14); // <-- Starting value
+  // ---------------------------------------------
+
+  TV.clear_screen(); // Clear screen
+}
+
+void loop() {
+  static int current_image = 0;
+
+  // The next image once the melody is over
+  if (TV.is_playing())
+    return;
+  
+  // Read pointer to the current compressed image from Flash
+  const unsigned char *current_image_compressed_ptr = (const unsigned char *)pgm_read_word_near(image_list_compressed + current_image);
+  
+  // Display the @KIND@ compressed image at position (0,0), it replaces the
+  // previous one within a frame so there is no need to clear the screen
+  TV.@DRAW@;
+  
+  // Play the melody
+  TV.play(melody);
+  
+  // Move to the next image
+  // Read num_images from Flash
+  int total_images = pgm_read_word_near(&num_images);
+  current_image = (current_image + 1) % total_images;
+}
+)INO";
+
+static std::string replace_all(std::string s, const std::string & a, const std::string & b) {
+	for (size_t p = 0; (p = s.find(a, p)) != std::string::npos; p += b.size())
+		s.replace(p, a.size(), b);
+	return s;
+}
+
+/*
+ * The sketch and the .pbm of every image, shared by the compressed formats.
+ */
+static bool write_ino(const std::string & dir, const std::string & project, const Options & opt,
+		const std::string & list, const std::string & tables, const char * kind,
+		const std::string & draw, const std::vector<Result> & res) {
+	std::string ino = ino_template + 1;
+	ino = replace_all(ino, "@PROJECT@", project);
+	ino = replace_all(ino, "@KIND@", kind);
+	ino = replace_all(ino, "@DRAW@", draw);
+	ino = replace_all(ino, "@LIST@", list);
+	ino = replace_all(ino, "@TABLES@", tables);
+	ino = replace_all(ino, "@COUNT@", std::to_string(res.size()));
+	ino = replace_all(ino, "@W@", std::to_string(opt.width));
+	ino = replace_all(ino, "@H@", std::to_string(opt.height));
+	FILE * f = fopen((dir + "/" + project + ".ino").c_str(), "w");
+	if (!f)
+		return false;
+	fputs(ino.c_str(), f);
+	fclose(f);
+
+	for (size_t i = 0; i < res.size(); i++) {
+		f = fopen((dir + "/" + res[i].name + ".pbm").c_str(), "wb");
+		if (!f)
+			return false;
+		fprintf(f, "P4\n%d %d\n", res[i].w, res[i].h);
+		fwrite(res[i].bits.data(), 1, res[i].bits.size(), f);
+		fclose(f);
+	}
+	return true;
+}
+
+static bool write_compressed(const std::string & dir, const std::string & project,
+		const Options & opt, char ** inputs, const std::vector<Result> & res) {
+	std::string up = project;
+	for (size_t i = 0; i < up.size(); i++)
+		up[i] = toupper((unsigned char)up[i]);
+	std::string base = dir + "/" + project;
+
+	FILE * f = fopen((base + ".h").c_str(), "w");
+	if (!f)
+		return false;
+	fprintf(f, "#ifndef %s_H\n#define %s_H\n\n#include <avr/pgmspace.h>\n\n", up.c_str(), up.c_str());
+	for (size_t i = 0; i < res.size(); i++)
+		fprintf(f, "extern const unsigned char %s_compressed[];\n", res[i].name.c_str());
+	fprintf(f, "\n#endif // %s_H\n", up.c_str());
+	fclose(f);
+
+	f = fopen((base + ".cpp").c_str(), "w");
+	if (!f)
+		return false;
+	const char * kind = opt.format == FORMAT_LZ ? "LZ" : "RLE";
+	fprintf(f, "// Data file for images (%s compressed)\n// Generated by img2tv\n#include \"%s.h\"\n\n",
+		kind, project.c_str());
+	for (size_t i = 0; i < res.size(); i++) {
+		const Result & r = res[i];
+		unsigned raw = r.bits.size() | (opt.format == FORMAT_BRLE ? 0x8000 : 0), n = r.data.size();
+		fprintf(f, "// %s compressed data for image '%s'\n", kind, inputs[i]);
+		fprintf(f, "PROGMEM const unsigned char %s_compressed[] = {\n", r.name.c_str());
+		fprintf(f, "  %u, %u, %u, %u,", raw & 0xFF, raw >> 8 & 0xFF, n & 0xFF, n >> 8 & 0xFF);
+		for (unsigned k = 0; k < n; k++)
+			fprintf(f, "0x%02x%s", r.data[k], k + 1 == n ? "" : k % 16 == 15 ? ",\n  " : ",");
+		fprintf(f, "\n\n};\n\n");
+	}
+	fclose(f);
+
+	std::string list;
+	for (size_t i = 0; i < res.size(); i++)
+		list += "  " + res[i].name + "_compressed,\n";
+	list.erase(list.size() - 1);
+	std::string draw = opt.format == FORMAT_LZ ? "lz_bitmap" : "rle_bitmap";
+	return write_ino(dir, project, opt, list, "", kind, draw + "(0, 0, current_image_compressed_ptr)", res);
+}
+
+/*
+ * -f tile: one bank of tiles for all images, as long as they fit into 256
+ * tiles, then the next bank is started.
+ */
+static bool write_tiles(const std::string & dir, const std::string & project,
+		const Options & opt, char ** inputs, const std::vector<Result> & res) {
+	std::vector<TileBank> banks(1);
+	std::vector<std::vector<uint8_t> > maps(res.size());
+	std::vector<int> bank_of(res.size());
+	for (size_t i = 0; i < res.size(); i++) {
+		const Result & r = res[i];
+		if (!tile_encode(r.bits, r.w/8, r.h, banks.back(), maps[i])) {
+			banks.emplace_back();
+			tile_encode(r.bits, r.w/8, r.h, banks.back(), maps[i]);
+		}
+		bank_of[i] = banks.size() - 1;
+	}
+
+	std::string up = project;
+	for (size_t i = 0; i < up.size(); i++)
+		up[i] = toupper((unsigned char)up[i]);
+	std::string base = dir + "/" + project;
+
+	FILE * f = fopen((base + ".h").c_str(), "w");
+	if (!f)
+		return false;
+	fprintf(f, "#ifndef %s_H\n#define %s_H\n\n#include <avr/pgmspace.h>\n\n", up.c_str(), up.c_str());
+	for (size_t b = 0; b < banks.size(); b++)
+		fprintf(f, "extern const unsigned char %s_tiles%u[];\n", project.c_str(), (unsigned)b);
+	fprintf(f, "\n");
+	for (size_t i = 0; i < res.size(); i++)
+		fprintf(f, "extern const unsigned char %s_map[];\n#define %s_tiles %s_tiles%d\n",
+			res[i].name.c_str(), res[i].name.c_str(), project.c_str(), bank_of[i]);
+	fprintf(f, "\n#endif // %s_H\n", up.c_str());
+	fclose(f);
+
+	f = fopen((base + ".cpp").c_str(), "w");
+	if (!f)
+		return false;
+	fprintf(f, "// Data file for images (8x8 tiles)\n// Generated by img2tv\n#include \"%s.h\"\n\n",
+		project.c_str());
+	size_t refs = 0, bytes = 0;
+	for (size_t b = 0; b < banks.size(); b++) {
+		const std::vector<uint64_t> & t = banks[b].tiles;
+		fprintf(f, "// %u tiles of 8 bytes, top row first\n", (unsigned)t.size());
+		fprintf(f, "PROGMEM const unsigned char %s_tiles%u[] = {\n", project.c_str(), (unsigned)b);
+		for (size_t k = 0; k < t.size(); k++) {
+			fprintf(f, "  ");
+			for (int s = 56; s >= 0; s -= 8)
+				fprintf(f, "0x%02x%s", (unsigned)(t[k] >> s & 0xFF), s || k + 1 < t.size() ? "," : "");
+			fprintf(f, "\n");
+		}
+		fprintf(f, "};\n\n");
+		bytes += t.size()*8;
+	}
+	for (size_t i = 0; i < res.size(); i++) {
+		const std::vector<uint8_t> & m = maps[i];
+		fprintf(f, "// tile map for image '%s', %ux%u tiles of %s_tiles%d\n",
+			inputs[i], m[0], m[1], project.c_str(), bank_of[i]);
+		fprintf(f, "PROGMEM const unsigned char %s_map[] = {\n  %u, %u,", res[i].name.c_str(), m[0], m[1]);
+		for (size_t k = 2; k < m.size(); k++)
+			fprintf(f, "%s%u%s", (k - 2) % m[0] ? "" : "\n  ", m[k], k + 1 == m.size() ? "" : ",");
+		fprintf(f, "\n};\n\n");
+		refs += m.size() - 2;
+		bytes += m.size();
+	}
+	fclose(f);
+
+	std::string list, tables = "\n\n// Tile bank of every image\nconst unsigned char * const image_tiles[] PROGMEM = {\n";
+	for (size_t i = 0; i < res.size(); i++) {
+		list += "  " + res[i].name + "_map,\n";
+		tables += "  " + res[i].name + "_tiles,\n";
+	}
+	list.erase(list.size() - 1);
+	tables += "};";
+	if (!write_ino(dir, project, opt, list, tables, "tile",
+			"tile_bitmap(0, 0, current_image_compressed_ptr,\n"
+			"    (const unsigned char *)pgm_read_word_near(image_tiles + current_image))", res))
+		return false;
+
+	size_t unique = 0, raw = 0;
+	for (size_t b = 0; b < banks.size(); b++)
+		unique += banks[b].tiles.size();
+	for (size_t i = 0; i < res.size(); i++)
+		raw += res[i].bits.size();
+	printf("%u tiles, %u unique in %u bank(s), dedupe ratio %.2f:1, %u bytes (original: %u bytes)\n",
+		(unsigned)refs, (unsigned)unique, (unsigned)banks.size(), (double)refs/unique,
+		(unsigned)bytes, (unsigned)raw);
+	return true;
+}
+
+/*
+ * img2tvout.sh layout, white pixels are set bits.
+ */
+static bool write_bitmap(const std::string & dir, const Result & r) {
+	std::string base = dir + "/" + r.name;
+	FILE * f = fopen((base + ".cpp").c_str(), "w");
+	if (!f)
+		return false;
+	fprintf(f, "#include \"%s.h\"\nPROGMEM const unsigned char %s[] = {\n%d,%d,\n",
+		r.name.c_str(), r.name.c_str(), r.w, r.h);
+	for (size_t k = 0; k < r.bits.size(); k++) {
+		fprintf(f, "0b");
+		for (int b = 7; b >= 0; b--)
+			fputc(~r.bits[k] >> b & 1 ? '1' : '0', f);
+		fprintf(f, "%s\n", k + 1 == r.bits.size() ? "" : ",");
+	}
+	fprintf(f, "};\n");
+	fclose(f);
+
+	f = fopen((base + ".h").c_str(), "w");
+	if (!f)
+		return false;
+	fprintf(f, "#include <avr/pgmspace.h>\n#ifndef %s_H\n#define %s_H\nextern const unsigned char %s[];\n#endif\n",
+		r.name.c_str(), r.name.c_str(), r.name.c_str());
+	fclose(f);
+	return true;
+}
+
+// the sketch written along with an animation
+static const char anim_template[] = R"INO(
+#include <TVout.h>
+
+TVout TV;
+
+#include "@PROJECT@.h"
+
+void setup() {
+  TV.begin(NTSC, @W@, @H@);
+  // TV.begin(PAL, @W@, @H@); // For PAL region
+  TV.anim_begin(0, 0, @PROJECT@);
+}
+
+void loop() {
+  // returning from delay_frame() is the start of the vertical blank, the
+  // time to apply the next frame without tearing
+  TV.delay_frame(1);
+  TV.anim_update();
+}
+)INO";
+
+/*
+ * img2tv -f anim: all inputs, and all frames of GIF inputs, in order are one
+ * animation written as <dir>/<project>.cpp, .h and .ino.
+ */
+static int write_anim(const std::string & dir, const std::string & project, const Options & opt,
+		char ** inputs, int count, int jobs) {
+	std::vector<Image> frames;
+	for (int k = 0; k < count; k++) {
+		std::string err;
+		if (!load_image(inputs[k], frames, err)) {
+			fprintf(stderr, "img2tv: %s: %s\n", inputs[k], err.c_str());
+			return 1;
+		}
+	}
+	if (frames.size() > 0xFFFF) {
+		fprintf(stderr, "img2tv: too many frames\n");
+		return 1;
+	}
+
+	int fps = opt.fps;
+	if (!fps)
+		fps = frames[0].delay ? 100/frames[0].delay : 10;
+	fps = std::max(1, std::min(fps, 60));
+
+	auto t0 = std::chrono::steady_clock::now();
+	int wb = (opt.width + 7)/8, h = opt.height;
+	std::vector<std::vector<uint8_t> > bits(frames.size());
+	int threads = parallel_for(jobs, frames.size(), [&](int k) {
+		fit(frames[k], opt.width, opt.height, true);
+		adjust(frames[k], opt);
+		dither(frames[k], opt.dither, bits[k]);
+		// the screen has white as set bits, unlike PBM
+		for (size_t i = 0; i < bits[k].size(); i++) {
+			if (!opt.invert)
+				bits[k][i] = ~bits[k][i];
+			if (i % wb == (size_t)wb - 1 && opt.width % 8)
+				bits[k][i] &= 0xFF00 >> opt.width % 8;
+		}
+	});
+
+	int n = frames.size();
+	std::vector<uint8_t> out, blank((size_t)wb*h, 0);
+	unsigned loop = 0;
+	out.push_back(opt.width);
+	out.push_back(h);
+	out.push_back(fps);
+	out.push_back(n & 0xFF);
+	out.push_back(n >> 8);
+	out.push_back(0);
+	out.push_back(0);
+	for (int k = 0; k < n; k++) {
+		anim_delta(k ? bits[k - 1] : blank, bits[k], wb, h, out);
+		if (!k)
+			loop = out.size();
+	}
+	if (n > 1)
+		anim_delta(bits[n - 1], bits[0], wb, h, out);
+	out[5] = loop & 0xFF;
+	out[6] = loop >> 8;
+	double total = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
+	if (mkdir(dir.c_str(), 0777) && errno != EEXIST) {
+		fprintf(stderr, "img2tv: cannot create %s\n", dir.c_str());
+		return 1;
+	}
+	std::string up = project, base = dir + "/" + project;
+	for (size_t i = 0; i < up.size(); i++)
+		up[i] = toupper((unsigned char)up[i]);
+	FILE * f = fopen((base + ".h").c_str(), "w");
+	if (f) {
+		fprintf(f, "#ifndef %s_H\n#define %s_H\n\n#include <avr/pgmspace.h>\n\n"
+			"extern const unsigned char %s[];\n\n#endif // %s_H\n",
+			up.c_str(), up.c_str(), project.c_str(), up.c_str());
+		fclose(f);
+		f = fopen((base + ".cpp").c_str(), "w");
+	}
+	if (f) {
+		fprintf(f, "// Delta frame animation, %d frames of %dx%d at %d fps\n// Generated by img2tv\n"
+			"#include \"%s.h\"\n\nPROGMEM const unsigned char %s[] = {\n",
+			n, opt.width, h, fps, project.c_str(), project.c_str());
+		for (size_t k = 0; k < out.size(); k++)
+			fprintf(f, "%s0x%02x%s", k % 16 ? "" : "  ", out[k],
+				k + 1 == out.size() ? "\n" : k % 16 == 15 ? ",\n" : ",");
+		fprintf(f, "};\n");
+		fclose(f);
+		f = fopen((base + ".ino").c_str(), "w");
+	}
+	if (!f) {
+		fprintf(stderr, "img2tv: cannot write to %s\n", dir.c_str());
+		return 1;
+	}
+	std::string ino = anim_template + 1;
+	ino = replace_all(ino, "@PROJECT@", project);
+	ino = replace_all(ino, "@W@", std::to_string(opt.width));
+	ino = replace_all(ino, "@H@", std::to_string(h));
+	fputs(ino.c_str(), f);
+	fclose(f);
+
+	printf("%d frame(s) at %d fps: %u bytes, %.1f bytes per frame (raw frame: %d bytes)\n",
+		n, fps, (unsigned)out.size(), (double)(out.size() - 7)/n, wb*h);
+	printf("converted in %.1f ms on %d thread(s), output in '%s'\n", total, threads, dir.c_str());
+	return 0;
+}
+
+/*
+ * -f sheet: every frame of the inputs is a sprite, directories are read in
+ * name order. All sprites go into one array for TVout::sprite():
+ *	{count, count * {offset_lo, offset_hi, width, height, hotspot x, y}, rows...}
+ * with rows as for TVout::bitmap(), identical sprites share their rows.
+ */
+struct Sprite {
+	std::string name;
+	Image img;
+	std::vector<uint8_t> bits;
+	int hx, hy;
+	unsigned offset;
+	bool shared;	// rows of an earlier sprite
+};
+
+static bool image_file(const std::string & name) {
+	static const char * ext[] = { ".pbm", ".pgm", ".ppm", ".pnm", ".png", ".gif" };
+	size_t dot = name.rfind('.');
+	if (dot == std::string::npos)
+		return false;
+	std::string e = name.substr(dot);
+	for (size_t i = 0; i < e.size(); i++)
+		e[i] = tolower((unsigned char)e[i]);
+	for (size_t i = 0; i < sizeof(ext)/sizeof(ext[0]); i++)
+		if (e == ext[i])
+			return true;
+	return false;
+}
+
+static int write_sheet(const std::string & dir, const std::string & project, const Options & opt,
+		char ** inputs, int count, int jobs) {
+	std::vector<std::string> files;
+	for (int k = 0; k < count; k++) {
+		struct stat st;
+		DIR * d;
+		if (stat(inputs[k], &st) || !S_ISDIR(st.st_mode) || !(d = opendir(inputs[k]))) {
+			files.push_back(inputs[k]);
+			continue;
+		}
+		std::vector<std::string> names;
+		while (struct dirent * e = readdir(d))
+			if (image_file(e->d_name))
+				names.push_back(std::string(inputs[k]) + "/" + e->d_name);
+		closedir(d);
+		std::sort(names.begin(), names.end());
+		files.insert(files.end(), names.begin(), names.end());
+	}
+
+	std::vector<Sprite> sprites;
+	for (size_t k = 0; k < files.size(); k++) {
+		std::vector<Image> frames;
+		std::string err;
+		if (!load_image(files[k].c_str(), frames, err)) {
+			fprintf(stderr, "img2tv: %s: %s\n", files[k].c_str(), err.c_str());
+			return 1;
+		}
+		std::string name = array_name(files[k].c_str());
+		for (size_t f = 0; f < frames.size(); f++) {
+			Sprite sp;
+			sp.name = frames.size() > 1 ? name + "_" + std::to_string(f) : name;
+			sp.img = std::move(frames[f]);
+			sprites.push_back(std::move(sp));
+		}
+	}
+	if (sprites.size() > 255) {
+		fprintf(stderr, "img2tv: a sheet holds at most 255 sprites\n");
+		return 1;
+	}
+
+	auto t0 = std::chrono::steady_clock::now();
+	int threads = parallel_for(jobs, sprites.size(), [&](int k) {
+		Sprite & sp = sprites[k];
+		Image & img = sp.img;
+		int ow = img.w, oh = img.h;
+		fit(img, std::min(opt.width, 255), std::min(opt.height, 255), false);
+
+		// hotspot in the scaled frame
+		if (opt.hotspot == "c" || opt.hotspot == "b") {
+			sp.hx = img.w/2;
+			sp.hy = opt.hotspot == "c" ? img.h/2 : img.h - 1;
+		}
+		else if (sscanf(opt.hotspot.c_str(), "%d,%d", &sp.hx, &sp.hy) == 2) {
+			sp.hx = sp.hx*img.w/ow;
+			sp.hy = sp.hy*img.h/oh;
+		}
+		else
+			sp.hx = sp.hy = 0;
+
+		std::vector<uint8_t> bits;
+		adjust(img, opt);
+		dither(img, opt.dither, bits);
+		int stride = (img.w + 7)/8;
+		auto white = [&](int x, int y) {
+			return !(bits[(size_t)y*stride + x/8] >> (7 - (x & 7)) & 1) != opt.invert;
+		};
+		int x0 = 0, y0 = 0, x1 = img.w, y1 = img.h;
+		if (opt.trim) {
+			x0 = img.w;
+			y0 = img.h;
+			x1 = y1 = 0;
+			for (int y = 0; y < img.h; y++)
+				for (int x = 0; x < img.w; x++)
+					if (white(x, y)) {
+						x0 = std::min(x0, x);
+						y0 = std::min(y0, y);
+						x1 = std::max(x1, x + 1);
+						y1 = std::max(y1, y + 1);
+					}
+			if (x0 >= x1) {
+				// nothing but black, keep a single pixel
+				x0 = y0 = 0;
+				x1 = y1 = 1;
+			}
+		}
+		img.w = x1 - x0;
+		img.h = y1 - y0;
+		sp.hx -= x0;
+		sp.hy -= y0;
+		sp.hx = std::max(-128, std::min(sp.hx, 127));
+		sp.hy = std::max(-128, std::min(sp.hy, 127));
+		int sb = (img.w + 7)/8;
+		sp.bits.assign((size_t)sb*img.h, 0);
+		for (int y = 0; y < img.h; y++)
+			for (int x = 0; x < img.w; x++)
+				if (white(x + x0, y + y0))
+					sp.bits[(size_t)y*sb + x/8] |= 0x80 >> (x & 7);
+	});
+
+	// index first, then the rows of every distinct sprite
+	size_t n = sprites.size(), size = 1 + 6*n, separate = 0, distinct = 0;
+	std::vector<uint8_t> rows;
+	for (size_t k = 0; k < n; k++) {
+		Sprite & sp = sprites[k];
+		size_t j = 0;
+		while (j < k && (sprites[j].img.w != sp.img.w || sprites[j].img.h != sp.img.h || sprites[j].bits != sp.bits))
+			j++;
+		sp.shared = j < k;
+		if (sp.shared)
+			sp.offset = sprites[j].offset;
+		else {
+			distinct++;
+			sp.offset = size + rows.size();
+			rows.insert(rows.end(), sp.bits.begin(), sp.bits.end());
+		}
+		separate += 2 + sp.bits.size() + 2;	// own array with header, plus a pointer
+	}
+	size += rows.size();
+	if (size > 0xFFFF) {
+		fprintf(stderr, "img2tv: the sheet is larger than 64k\n");
+		return 1;
+	}
+	double total = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
+	if (mkdir(dir.c_str(), 0777) && errno != EEXIST) {
+		fprintf(stderr, "img2tv: cannot create %s\n", dir.c_str());
+		return 1;
+	}
+	std::string up = project, base = dir + "/" + project;
+	for (size_t i = 0; i < up.size(); i++)
+		up[i] = toupper((unsigned char)up[i]);
+	FILE * f = fopen((base + ".h").c_str(), "w");
+	if (f) {
+		fprintf(f, "#ifndef %s_H\n#define %s_H\n\n#include <avr/pgmspace.h>\n\n"
+			"extern const unsigned char %s[];\n\n// sprite numbers for TV.sprite(x, y, %s, n)\n",
+			up.c_str(), up.c_str(), project.c_str(), project.c_str());
+		for (size_t k = 0; k < n; k++) {
+			std::string id = sprites[k].name;
+			for (size_t i = 0; i < id.size(); i++)
+				id[i] = toupper((unsigned char)id[i]);
+			fprintf(f, "#define %s_%s %u\n", up.c_str(), id.c_str(), (unsigned)k);
+		}
+		fprintf(f, "#define %s_COUNT %u\n\n#endif // %s_H\n", up.c_str(), (unsigned)n, up.c_str());
+		fclose(f);
+		f = fopen((base + ".cpp").c_str(), "w");
+	}
+	if (!f) {
+		fprintf(stderr, "img2tv: cannot write to %s\n", dir.c_str());
+		return 1;
+	}
+	fprintf(f, "// Sprite sheet, %u sprites\n// Generated by img2tv\n#include \"%s.h\"\n\n"
+		"PROGMEM const unsigned char %s[] = {\n  %u,\n  // offset, width, height, hotspot\n",
+		(unsigned)n, project.c_str(), project.c_str(), (unsigned)n);
+	for (size_t k = 0; k < n; k++) {
+		const Sprite & sp = sprites[k];
+		fprintf(f, "  %u, %u, %u, %u, %u, %u,\t// %u %s\n", sp.offset & 0xFF, sp.offset >> 8,
+			sp.img.w, sp.img.h, sp.hx & 0xFF, sp.hy & 0xFF, (unsigned)k, sp.name.c_str());
+	}
+	for (size_t k = 0; k < n; k++) {
+		const Sprite & sp = sprites[k];
+		if (sp.shared)
+			continue;
+		int sb = (sp.img.w + 7)/8;
+		fprintf(f, "  // %s\n", sp.name.c_str());
+		for (int y = 0; y < sp.img.h; y++) {
+			fprintf(f, "  ");
+			for (int b = 0; b < sb; b++)
+				fprintf(f, "0x%02x,", sp.bits[(size_t)y*sb + b]);
+			fprintf(f, "\n");
+		}
+	}
+	fprintf(f, "};\n");
+	fclose(f);
+
+	printf("%u sprite(s), %u distinct: %u bytes (as separate bitmaps: %u bytes)\n",
+		(unsigned)n, (unsigned)distinct, (unsigned)size, (unsigned)separate);
+	printf("converted in %.1f ms on %d thread(s), output in '%s'\n", total, threads, dir.c_str());
+	return 0;
+}
+
+/*
+ * -D: every dithering method on every image, written as <name>_<method>.pbm
+ * with the compressed size of each, to pick the method for a project.
+ */
+static int preview(const std::string & dir, const Options & opt, char ** inputs, int count, int jobs) {
+	const int methods = sizeof(dither_names)/sizeof(dither_names[0]);
+	std::vector<Image> images(count);
+	std::vector<std::string> errors(count);
+	std::vector<Result> res((size_t)count*methods);
+
+	auto t0 = std::chrono::steady_clock::now();
+	parallel_for(jobs, count, [&](int k) {
+		std::vector<Image> frames;
+		if (!load_image(inputs[k], frames, errors[k]))
+			return;
+		images[k] = std::move(frames[0]);
+		fit(images[k], opt.width, opt.height, opt.format != FORMAT_BITMAP);
+		adjust(images[k], opt);
+	});
+	for (int k = 0; k < count; k++)
+		if (!errors[k].empty()) {
+			fprintf(stderr, "img2tv: %s: %s\n", inputs[k], errors[k].c_str());
+			return 1;
+		}
+	int threads = parallel_for(jobs, res.size(), [&](int k) {
+		const Image & img = images[k/methods];
+		Result & r = res[k];
+		dither(img, (Dither)(k % methods), r.bits);
+		if (opt.invert)
+			for (size_t i = 0; i < r.bits.size(); i++)
+				r.bits[i] = ~r.bits[i];
+		r.name = array_name(inputs[k/methods]) + "_" + dither_names[k % methods];
+		r.w = img.w;
+		r.h = img.h;
+		for (int f = 0; f < FORMAT_BITMAP; f++) {
+			std::vector<uint8_t> out;
+			r.sizes[f] = encode((Format)f, r.bits, r.w, r.h, out) ? out.size() : 0;
+		}
+	});
+	double total = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
+	if (mkdir(dir.c_str(), 0777) && errno != EEXIST) {
+		fprintf(stderr, "img2tv: cannot create %s\n", dir.c_str());
+		return 1;
+	}
+	for (size_t k = 0; k < res.size(); k++) {
+		const Result & r = res[k];
+		if (k % methods == 0)
+			printf("  - %s: %dx%d, %u bytes uncompressed\n", inputs[k/methods], r.w, r.h, (unsigned)r.bits.size());
+		printf("      %-9s", dither_names[k % methods]);
+		for (int f = 0; f < FORMAT_BITMAP; f++)
+			if (r.sizes[f])
+				printf(" %s %5u", format_names[f], (unsigned)r.sizes[f]);
+		printf(" bytes\n");
+		FILE * f = fopen((dir + "/" + r.name + ".pbm").c_str(), "wb");
+		if (!f) {
+			fprintf(stderr, "img2tv: cannot write to %s\n", dir.c_str());
+			return 1;
+		}
+		fprintf(f, "P4\n%d %d\n", r.w, r.h);
+		fwrite(r.bits.data(), 1, r.bits.size(), f);
+		fclose(f);
+	}
+	printf("%d variant(s) in %.1f ms on %d thread(s), previews in '%s'\n",
+		(int)res.size(), total, threads, dir.c_str());
+	return 0;
+}
+
+static void usage() {
+	fprintf(stderr,
+		"usage: img2tv [-f rle|brle|lz|tile|bitmap|sheet|anim] [-o dir] [-p project] [-s WxH]\n"
+		"              [-d fs|atkinson|bayer|blue|none] [-D] [-g gamma] [-k contrast] [-i] [-j n] [-c]\n"
+		"              [-r fps] [-H x,y|c|b] [-t] image...\n"
+		"  converts images for TVout, see the source for details\n");
+	exit(1);
+}
+
+int main(int argc, char ** argv) {
+	Options opt = { FORMAT_RLE, 128, 96, DITHER_FS, 1, 1, false, false, 0, "0,0", false };
+	bool all_dithers = false;
+	std::string dir, project;
+	int jobs = std::thread::hardware_concurrency();
+	int i;
+
+	for (i = 1; i < argc && argv[i][0] == '-'; i++) {
+		std::string a = argv[i];
+		if (i + 1 >= argc && a != "-i" && a != "-c" && a != "-t" && a != "-D")
+			usage();
+		if (a == "-f") {
+			std::string f = argv[++i];
+			int k = 0;
+			while (k <= FORMAT_ANIM && f != format_names[k])
+				k++;
+			if (k > FORMAT_ANIM)
+				usage();
+			opt.format = (Format)k;
+		}
+		else if (a == "-o")
+			dir = argv[++i];
+		else if (a == "-p")
+			project = argv[++i];
+		else if (a == "-s") {
+			if (sscanf(argv[++i], "%dx%d", &opt.width, &opt.height) != 2 ||
+				opt.width < 8 || opt.width > 256 || opt.height < 1 || opt.height > 256)
+				usage();
+		}
+		else if (a == "-d") {
+			std::string d = argv[++i];
+			int k = 0;
+			while (k <= DITHER_BLUE && d != dither_names[k])
+				k++;
+			if (k > DITHER_BLUE)
+				usage();
+			opt.dither = (Dither)k;
+		}
+		else if (a == "-D")
+			all_dithers = true;
+		else if (a == "-g") {
+			opt.gamma = atof(argv[++i]);
+			if (opt.gamma <= 0)
+				usage();
+		}
+		else if (a == "-k")
+			opt.contrast = atof(argv[++i]);
+		else if (a == "-i")
+			opt.invert = true;
+		else if (a == "-c")
+			opt.compare = true;
+		else if (a == "-j")
+			jobs = atoi(argv[++i]);
+		else if (a == "-r")
+			opt.fps = atoi(argv[++i]);
+		else if (a == "-H")
+			opt.hotspot = argv[++i];
+		else if (a == "-t")
+			opt.trim = true;
+		else
+			usage();
+	}
+	if (i == argc)
+		usage();
+	if (project.empty())
+		project = opt.format == FORMAT_ANIM ? "animation" : opt.format == FORMAT_SHEET ? "sprites" : "images";
+	if (dir.empty())
+		dir = "converted_" + project;
+	if (jobs < 1)
+		jobs = 1;
+
+	char ** inputs = argv + i;
+	int count = argc - i;
+	if (all_dithers)
+		return preview(dir, opt, inputs, count, jobs);
+	if (opt.format == FORMAT_ANIM) {
+		if (opt.height > 255)
+			usage();
+		return write_anim(dir, project, opt, inputs, count, jobs);
+	}
+	if (opt.format == FORMAT_SHEET)
+		return write_sheet(dir, project, opt, inputs, count, jobs);
+
+	std::vector<Result> res(count);
+	auto t0 = std::chrono::steady_clock::now();
+	int threads = parallel_for(jobs, count, [&](int k) {
+		convert(inputs[k], opt, res[k]);
+	});
+
+	double total = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+	int failed = 0;
+	for (int k = 0; k < count; k++) {
+		if (!res[k].error.empty()) {
+			fprintf(stderr, "img2tv: %s: %s\n", inputs[k], res[k].error.c_str());
+			failed++;
+		}
+		else if (opt.format != FORMAT_BITMAP)
+			printf("  - %s: %u bytes compressed (original: %u bytes), %.1f ms\n",
+				inputs[k], (unsigned)res[k].data.size(), (unsigned)res[k].bits.size(), res[k].ms);
+		else
+			printf("  - %s: %dx%d bitmap, %.1f ms\n", inputs[k], res[k].w, res[k].h, res[k].ms);
+		if (opt.compare && res[k].error.empty()) {
+			printf("     ");
+			for (int f = 0; f < FORMAT_BITMAP; f++)
+				if (res[k].sizes[f])
+					printf(" %s %u", format_names[f], (unsigned)res[k].sizes[f]);
+			printf(" bytes\n");
+		}
+	}
+	if (failed)
+		return 1;
+
+	if (mkdir(dir.c_str(), 0777) && errno != EEXIST) {
+		fprintf(stderr, "img2tv: cannot create %s\n", dir.c_str());
+		return 1;
+	}
+	bool ok = true;
+	if (opt.format == FORMAT_TILE)
+		ok = write_tiles(dir, project, opt, inputs, res);
+	else if (opt.format != FORMAT_BITMAP)
+		ok = write_compressed(dir, project, opt, inputs, res);
+	else
+		for (int k = 0; k < count && ok; k++)
+			ok = write_bitmap(dir, res[k]);
+	if (!ok) {
+		fprintf(stderr, "img2tv: cannot write to %s\n", dir.c_str());
+		return 1;
+	}
+	printf("%d image(s) converted in %.1f ms on %d thread(s), output in '%s'\n",
+		count, total, threads, dir.c_str());
+	return 0;
+}
@@ -0,0 +1,259 @@
+/*
+ * tvcapture - save the screens sent by TVout::dump() as PBM files.
+ *
+ * Build on the host (Linux):
+ *	g++ -O2 -o tvcapture tvcapture.cpp
+ *
+ * Usage:
+ *	tvcapture [options] device
+ *
+ *	-b baud		line speed, as passed to dump(), default 115200
+ *	-o prefix	write prefix0000.pbm, prefix0001.pbm, ..., default capture
+ *	-n count	stop after count screens, default run until interrupted
+ *	-c golden.pbm	compare every screen with golden.pbm, print the number
+ *			of differing pixels and exit with 1 if any differs.
+ *			count defaults to 1
+ *
+ * The stream is searched for the PBM header dump() sends, anything else on
+ * the line such as debug prints is skipped. Every screen is written with the
+ * frame number from the header, which tells how many frames the sketch took
+ * between two dumps:
+ *	capture0003.pbm: 128x96, frame 1234 (+60)
+ *
+ * Golden image tests of drawing code: dump() after drawing in the sketch,
+ * capture once and check the picture, then compare later builds with -c.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <asm/ioctls.h>
+#include <asm/termbits.h>
+
+#include <string>
+#include <vector>
+
+// <sys/ioctl.h> clashes with <asm/termbits.h>, which has termios2
+extern "C" int ioctl(int fd, unsigned long request, ...);
+
+static void die(const char * msg, const char * arg = "") {
+	fprintf(stderr, "tvcapture: %s%s%s%s\n", msg, arg, errno ? ": " : "", errno ? strerror(errno) : "");
+	exit(2);
+}
+
+/*
+ * raw 8N1 at any rate, termios2 takes the baud rate as a number
+ */
+static int open_port(const char * path, unsigned baud) {
+	int fd = open(path, O_RDONLY | O_NOCTTY);
+	if (fd < 0)
+		die("cannot open ", path);
+
+	struct termios2 tio;
+	if (ioctl(fd, TCGETS2, &tio) == 0) {
+		tio.c_iflag = 0;
+		tio.c_oflag = 0;
+		tio.c_lflag = 0;
+		tio.c_cflag = CS8 | CREAD | CLOCAL | BOTHER;
+		tio.c_ispeed = baud;
+		tio.c_ospeed = baud;
+		tio.c_cc[VMIN] = 1;
+		tio.c_cc[VTIME] = 0;
+		if (ioctl(fd, TCSETS2, &tio))
+			die("cannot set up ", path);
+	}
+	errno = 0;
+	return fd;
+}
+
+// buffered bytes of the serial port
+struct Port {
+	int fd;
+	uint8_t buf[4096];
+	int pos, len;
+
+	int get() {
+		while (pos == len) {
+			ssize_t n = read(fd, buf, sizeof(buf));
+			if (n == 0)
+				return -1;
+			if (n < 0) {
+				if (errno == EINTR)
+					continue;
+				die("read failed");
+			}
+			pos = 0;
+			len = n;
+		}
+		return buf[pos++];
+	}
+};
+
+struct Screen {
+	int w, h;
+	unsigned long frame;
+	std::vector<uint8_t> bits;
+};
+
+static long header_number(Port & p, int & c) {
+	long v = 0;
+	if (c < '0' || c > '9')
+		return -1;
+	for (; c >= '0' && c <= '9'; c = p.get())
+		v = v*10 + c - '0';
+	return v;
+}
+
+/*
+ * next "P4\n# frame <n>\n<w> <h>\n" and its rows, false at the end of input
+ */
+static bool read_screen(Port & p, Screen & s) {
+	int c = p.get();
+	for (;;) {
+		while (c >= 0 && c != 'P')
+			c = p.get();
+		if (c < 0)
+			return false;
+		if ((c = p.get()) != '4' || (c = p.get()) != '\n')
+			continue;
+		const char * tag = "# frame ";
+		while (*tag && (c = p.get()) == *tag)
+			tag++;
+		if (*tag)
+			continue;
+		c = p.get();
+		long frame = header_number(p, c);
+		if (frame < 0 || c != '\n')
+			continue;
+		c = p.get();
+		long w = header_number(p, c);
+		if (w <= 0 || w % 8 || c != ' ')
+			continue;
+		c = p.get();
+		long h = header_number(p, c);
+		if (h <= 0 || h > 256 || c != '\n')
+			continue;
+
+		s.w = w;
+		s.h = h;
+		s.frame = frame;
+		s.bits.resize(w/8*h);
+		for (size_t i = 0; i < s.bits.size(); i++) {
+			if ((c = p.get()) < 0)
+				return false;
+			s.bits[i] = c;
+		}
+		return true;
+	}
+}
+
+static bool load_pbm(const char * path, Screen & s) {
+	FILE * f = fopen(path, "rb");
+	if (!f)
+		return false;
+	int w = 0, h = 0;
+	char magic[3] = "";
+	int c;
+	if (fscanf(f, "%2s", magic) != 1 || strcmp(magic, "P4"))
+		return false;
+	// fields, skipping comments
+	for (int field = 0; field < 2; ) {
+		c = getc(f);
+		if (c == '#')
+			while ((c = getc(f)) != EOF && c != '\n')
+				;
+		else if (c >= '0' && c <= '9') {
+			ungetc(c, f);
+			if (fscanf(f, "%d", field ? &h : &w) != 1)
+				return false;
+			field++;
+		}
+		else if (c == EOF)
+			return false;
+	}
+	getc(f);
+	s.w = w;
+	s.h = h;
+	s.bits.resize(w/8*h);
+	bool ok = w % 8 == 0 && fread(s.bits.data(), 1, s.bits.size(), f) == s.bits.size();
+	fclose(f);
+	return ok;
+}
+
+static void usage() {
+	fprintf(stderr,
+		"usage: tvcapture [-b baud] [-o prefix] [-n count] [-c golden.pbm] device\n"
+		"  saves the screens sent by TVout::dump(), see the source for details\n");
+	exit(2);
+}
+
+int main(int argc, char ** argv) {
+	unsigned baud = 115200;
+	std::string prefix = "capture";
+	long count = -1;
+	const char * golden_path = 0;
+	Screen golden, s;
+	int i;
+
+	for (i = 1; i < argc && argv[i][0] == '-'; i++) {
+		std::string a = argv[i];
+		if (i + 1 >= argc)
+			usage();
+		if (a == "-b")
+			baud = strtoul(argv[++i], 0, 10);
+		else if (a == "-o")
+			prefix = argv[++i];
+		else if (a == "-n")
+			count = atol(argv[++i]);
+		else if (a == "-c")
+			golden_path = argv[++i];
+		else
+			usage();
+	}
+	if (argc - i != 1 || !baud)
+		usage();
+	if (golden_path) {
+		if (!load_pbm(golden_path, golden))
+			die("cannot read PBM ", golden_path);
+		if (count < 0)
+			count = 1;
+	}
+
+	Port port = { open_port(argv[i], baud), {}, 0, 0 };
+	int failed = 0;
+	unsigned long last = 0;
+	for (long n = 0; n != count && read_screen(port, s); n++) {
+		char name[32];
+		snprintf(name, sizeof(name), "%04ld.pbm", n);
+		std::string path = prefix + name;
+		FILE * f = fopen(path.c_str(), "wb");
+		if (!f)
+			die("cannot write ", path.c_str());
+		fprintf(f, "P4\n# frame %lu\n%d %d\n", s.frame, s.w, s.h);
+		fwrite(s.bits.data(), 1, s.bits.size(), f);
+		fclose(f);
+
+		printf("%s: %dx%d, frame %lu", path.c_str(), s.w, s.h, s.frame);
+		if (n)
+			printf(" (+%lu)", s.frame - last);
+		last = s.frame;
+		if (golden_path) {
+			long diff = 0;
+			if (s.w != golden.w || s.h != golden.h)
+				diff = (long)s.w*s.h;
+			else
+				for (size_t k = 0; k < s.bits.size(); k++)
+					diff += __builtin_popcount(s.bits[k] ^ golden.bits[k]);
+			printf(", %ld pixel(s) differ from %s", diff, golden_path);
+			if (diff)
+				failed = 1;
+		}
+		printf("\n");
+		fflush(stdout);
+	}
+	return failed;
+}
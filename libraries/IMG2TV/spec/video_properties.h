@@ -47,8 +47,13 @@
 #define _NTSC_LINE_STOP_VSYNC           3
 #define _NTSC_LINE_DISPLAY              216
 #define _NTSC_LINE_MID                  ((_NTSC_LINE_FRAME - _NTSC_LINE_DISPLAY)/2 + _NTSC_LINE_DISPLAY/2)
+//a frame is the lines 0 to _NTSC_LINE_FRAME, the time drops the half us
+#define _NTSC_CYCLES_FRAME              ((long)_NTSC_CYCLES_LINE * (_NTSC_LINE_FRAME + 1))
+#define _NTSC_TIME_FRAME                (_NTSC_CYCLES_FRAME / _CYCLES_PER_US)
 
 #define _NTSC_CYCLES_SCANLINE           ((_NTSC_TIME_SCANLINE * _CYCLES_PER_US) - 1)
+//the line timer 1 really makes, ICR1 drops the fraction
+#define _NTSC_CYCLES_LINE               ((unsigned int)_NTSC_CYCLES_SCANLINE + 1)
 #define _NTSC_CYCLES_OUTPUT_START       ((_NTSC_TIME_OUTPUT_START * _CYCLES_PER_US) - 1)
 
 //Timing settings for PAL
@@ -60,8 +65,11 @@
 #define _PAL_LINE_STOP_VSYNC            7
 #define _PAL_LINE_DISPLAY               260
 #define _PAL_LINE_MID                   ((_PAL_LINE_FRAME - _PAL_LINE_DISPLAY)/2 + _PAL_LINE_DISPLAY/2)
+#define _PAL_CYCLES_FRAME               ((long)_PAL_CYCLES_LINE * (_PAL_LINE_FRAME + 1))
+#define _PAL_TIME_FRAME                 (_PAL_CYCLES_FRAME / _CYCLES_PER_US)
 
 #define _PAL_CYCLES_SCANLINE            ((_PAL_TIME_SCANLINE * _CYCLES_PER_US) - 1)
+#define _PAL_CYCLES_LINE                ((unsigned int)_PAL_CYCLES_SCANLINE + 1)
 #define _PAL_CYCLES_OUTPUT_START        ((_PAL_TIME_OUTPUT_START * _CYCLES_PER_US) - 1)
 
 #endif
@@ -25,6 +25,7 @@
 
 #include <avr/interrupt.h>
 #include <avr/io.h>
+#include <avr/pgmspace.h>
 
 #include "video_gen.h"
 #include "spec/video_properties.h"
@@ -43,8 +44,23 @@ void (*line_handler)();			//remove me
 void (*hbi_hook)() = &empty;
 void (*vbi_hook)() = &empty;
 
+// hook chain properties
+struct line_hook hbi_chain[HOOK_CHAIN];
+struct line_hook vbi_chain[HOOK_CHAIN];
+uint8_t hbi_count, vbi_count;
+
 // sound properties
 volatile long remainingToneVsyncs;
+volatile uint8_t timer2_owned;
+
+// sequencer properties
+const unsigned int * volatile song_note;
+long song_left;
+
+// deferred work properties
+struct work_item work_queue[WORK_QUEUE];
+volatile uint8_t work_head, work_tail;
+unsigned int work_end = WORK_BUDGET;
 
 void empty() {}
 
@@ -124,6 +140,49 @@ ISR(TIMER1_OVF_vect) {
 	line_handler();
 }
 
+/* Call the hooks of a chain that are due, highest priority first.
+ */
+static void inline walk(struct line_hook * h, uint8_t n) {
+	for (; n; n--, h++) {
+		if (--h->left)
+			continue;
+		h->left = h->every;
+#ifdef HOOK_CYCLES
+		unsigned int start = TCNT1, end;
+		h->func();
+		end = TCNT1;
+		if (end < start)
+			end += ICR1 + 1;
+		if (end - start > h->cycles)
+			h->cycles = end - start;
+#else
+		h->func();
+#endif
+	}
+}
+
+void hbi_walk() {
+	walk(hbi_chain, hbi_count);
+}
+
+void vbi_walk() {
+	walk(vbi_chain, vbi_count);
+}
+
+/* Run the queued work while the line has cycles left, work_end is checked
+ * between calls so a call has to fit in what remains of the line.
+ */
+static void run_work() {
+	uint8_t tail = work_tail;
+
+	// a call that ran past the end of the line wrapped TCNT1, the overflow
+	// flag tells, and the next line is already due
+	while (tail != work_head && TCNT1 < work_end && !(TIFR1 & _BV(TOV1))) {
+		if (!work_queue[tail].func(work_queue[tail].arg))
+			work_tail = tail = (tail + 1) & (WORK_QUEUE - 1);
+	}
+}
+
 void blank_line() {
 		
 	if ( display.scanLine == display.start_render) {
@@ -137,6 +196,9 @@ void blank_line() {
 	}
 	
 	display.scanLine++;
+
+	if (work_head != work_tail)
+		run_work();
 }
 
 void active_line() {
@@ -161,7 +223,11 @@ void vsync_line() {
 		display.scanLine = 0;
 		display.frames++;
 
-		if (remainingToneVsyncs != 0)
+		if (timer2_owned)
+			;	// an audio hook drives timer 2
+		else if (song_note)
+			song_frame();
+		else if (remainingToneVsyncs != 0)
 		{
 			if (remainingToneVsyncs > 0)
 			{
@@ -183,6 +249,45 @@ void vsync_line() {
 }
 
 
+/* Advance the song by one frame, called from vsync_line.
+ * song_left counts the us left of the current note, so note lengths are
+ * kept over the song even though they end on a frame. A note only loads
+ * prepared timer 2 settings, no division is done in the interrupt.
+ */
+void song_frame() {
+	unsigned int timer, ms;
+
+	while (song_left <= 0) {
+		timer = pgm_read_word(song_note);
+		ms = pgm_read_word(song_note + 1);
+		TCCR2B = 0;
+		if (!ms) {
+			song_note = 0;
+			remainingToneVsyncs = 0;
+			TCCR2A = _BV(WGM21);
+			PORT_SND &= ~_BV(SND_PIN);
+			return;
+		}
+		if (timer) {
+			TCCR2A = _BV(WGM21) | _BV(COM2A0);
+			TCNT2 = 0;
+			OCR2A = timer;
+			TCCR2B = timer >> 8;
+		}
+		else {
+			TCCR2A = _BV(WGM21);
+			PORT_SND &= ~_BV(SND_PIN);
+		}
+		song_note += 2;
+		song_left += ms * 1000L;
+	}
+	if (display.lines_frame == _NTSC_LINE_FRAME)
+		song_left -= _NTSC_TIME_FRAME;
+	else
+		song_left -= _PAL_TIME_FRAME;
+}
+
+
 static void inline wait_until(uint8_t time) {
 	__asm__ __volatile__ (
 			"subi	%[time], 10\n"
@@ -45,6 +45,27 @@ extern TVout_vid display;
 extern void (*hbi_hook)();
 extern void (*vbi_hook)();
 
+//hook chains, in priority order. hbi_hook and vbi_hook are the hook itself
+//when a chain holds one that runs every time, else the chain walk.
+//Uncomment HOOK_CYCLES to measure the cycles each hook takes, the chain is
+//then always walked.
+//#define HOOK_CYCLES
+#define HOOK_CHAIN	4
+struct line_hook {
+	void (*func)();
+	uint8_t priority;
+	uint8_t every;		// runs every that many lines or frames
+	uint8_t left;
+#ifdef HOOK_CYCLES
+	unsigned int cycles;	// the most a call took
+#endif
+};
+extern struct line_hook hbi_chain[HOOK_CHAIN];
+extern struct line_hook vbi_chain[HOOK_CHAIN];
+extern uint8_t hbi_count, vbi_count;
+void hbi_walk();
+void vbi_walk();
+
 void render_setup(uint8_t mode, uint8_t x, uint8_t y, uint8_t *scrnptr);
 
 void blank_line();
@@ -54,6 +75,26 @@ void empty();
 
 //tone generation properties
 extern volatile long remainingToneVsyncs;
+//set while an audio hook drives timer 2, tones and songs leave it alone
+extern volatile uint8_t timer2_owned;
+
+//sequencer properties, the next note of the song playing
+extern const unsigned int * volatile song_note;
+extern long song_left;
+void song_frame();
+
+//deferred work, run from blank lines until work_end cycles into the line.
+//A work function returns nonzero to be called again, 0 when it is done.
+#define WORK_QUEUE	8
+#define WORK_BUDGET	600
+typedef char (*work_func)(void * arg);
+struct work_item {
+	work_func func;
+	void * arg;
+};
+extern struct work_item work_queue[WORK_QUEUE];
+extern volatile uint8_t work_head, work_tail;
+extern unsigned int work_end;
 
 // 6cycles functions
 void render_line6c();
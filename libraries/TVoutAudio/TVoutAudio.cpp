@@ -0,0 +1,158 @@
+#include "TVoutAudio.h"
+#include <avr/interrupt.h>
+#include <TVout.h>
+
+AUDIO_WAVES(audio_waves) = {
+	// square
+	127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127,
+	-127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127,
+	// saw
+	-127, -119, -111, -102, -94, -86, -78, -70, -61, -53, -45, -37, -29, -20, -12, -4,
+	4, 12, 20, 29, 37, 45, 53, 61, 70, 78, 86, 94, 102, 111, 119, 127,
+	// triangle
+	-127, -110, -93, -76, -59, -42, -25, -8, 8, 25, 42, 59, 76, 93, 110, 127,
+	127, 110, 93, 76, 59, 42, 25, 8, -8, -25, -42, -59, -76, -93, -110, -127,
+	// sine
+	0, 25, 49, 71, 90, 106, 117, 125, 127, 125, 117, 106, 90, 71, 49, 25,
+	0, -25, -49, -71, -90, -106, -117, -125, -127, -125, -117, -106, -90, -71, -49, -25,
+	// pulse 25%
+	127, 127, 127, 127, 127, 127, 127, 127, -127, -127, -127, -127, -127, -127, -127, -127,
+	-127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127,
+	// pulse 12.5%
+	127, 127, 127, 127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127,
+	-127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127,
+	// noise
+	-127, -127, -127, -127, 127, 127, 127, -127, -127, 127, 127, -127, 127, -127, 127, -127,
+	127, -127, -127, -127, 127, -127, -127, 127, 127, 127, -127, -127, -127, 127, -127, 127,
+	// organ
+	0, 48, 89, 116, 127, 123, 108, 88, 69, 53, 44, 38, 35, 31, 24, 13,
+	0, -13, -24, -31, -35, -38, -44, -53, -69, -88, -108, -123, -127, -116, -89, -48,
+};
+
+struct audio_voice audio_voices[AUDIO_VOICES];
+static uint8_t bank;	// high byte of the waveform bank address
+
+// one voice, see the cycle counts in TVoutAudio.h
+#define MIX_VOICE(v) \
+	"lds	r18, %[" #v "]\n\t"		/* 2  phase += step */ \
+	"lds	r19, %[" #v "]+1\n\t"	/* 2 */ \
+	"lds	r20, %[" #v "]+2\n\t"	/* 2 */ \
+	"lds	r21, %[" #v "]+3\n\t"	/* 2 */ \
+	"add	r18, r20\n\t"			/* 1 */ \
+	"adc	r19, r21\n\t"			/* 1 */ \
+	"sts	%[" #v "], r18\n\t"		/* 2 */ \
+	"sts	%[" #v "]+1, r19\n\t"	/* 2 */ \
+	"mov	r30, r19\n\t"			/* 1  sample = wave[phase >> 11] */ \
+	"lsr	r30\n\t"				/* 1 */ \
+	"lsr	r30\n\t"				/* 1 */ \
+	"lsr	r30\n\t"				/* 1 */ \
+	"lds	r20, %[" #v "]+4\n\t"	/* 2 */ \
+	"or		r30, r20\n\t"			/* 1 */ \
+	"lpm	r22, Z\n\t"				/* 3 */ \
+	"lds	r23, %[" #v "]+5\n\t"	/* 2  out += sample*volume/256 */ \
+	"mulsu	r22, r23\n\t"			/* 2 */ \
+	"add	r24, r1\n\t"			/* 1 */
+
+// hbi hook: mix the voices and set the PWM duty for the line
+void audio_mix() {
+	__asm__ __volatile__ (
+		"lds	r31, %[bank]\n\t"		// 2
+		"ldi	r24, 0x80\n\t"			// 1
+		MIX_VOICE(v0)
+		MIX_VOICE(v1)
+		MIX_VOICE(v2)
+		"clr	r1\n\t"					// 1  mulsu used r1:r0
+		"sts	%[ocr], r24\n"			// 2
+		:
+		: [bank] "i" (&bank),
+		  [v0] "i" (&audio_voices[0]),
+		  [v1] "i" (&audio_voices[1]),
+		  [v2] "i" (&audio_voices[2]),
+		  [ocr] "n" (_SFR_MEM_ADDR(OCR2A))
+		: "r18", "r19", "r20", "r21", "r22", "r23", "r24", "r30", "r31"
+	);
+}
+
+// timer 2 as 8 bit fast PWM on the sound pin, no prescaler, at mid level.
+// Reserves the timer, so vsync_line stops touching it for tones and songs.
+void audio_pwm_begin() {
+	uint8_t sreg = SREG;
+	cli();
+	timer2_owned = 1;
+	song_note = 0;
+	remainingToneVsyncs = 0;
+	SREG = sreg;
+	OCR2A = 0x80;
+	TCCR2A = _BV(COM2A1) | _BV(WGM21) | _BV(WGM20);
+	TCCR2B = _BV(CS20);
+	DDR_SND |= _BV(SND_PIN);
+}
+
+void audio_pwm_end() {
+	TCCR2B = 0;
+	TCCR2A = 0;
+	PORT_SND &= ~_BV(SND_PIN);
+	timer2_owned = 0;
+}
+
+pt2Funct TVoutAudio::begin() {
+	for (uint8_t v = 0; v < AUDIO_VOICES; v++)
+		off(v);
+	bank = (uint16_t)audio_waves >> 8;
+	audio_pwm_begin();
+	return &audio_mix;
+}
+
+void TVoutAudio::end() {
+	audio_pwm_end();
+}
+
+void TVoutAudio::note(uint8_t voice, unsigned int frequency, uint8_t volume) {
+	this->frequency(voice, frequency);
+	this->volume(voice, volume);
+}
+
+/* The phase step is frequency*65536/line rate, worked out as
+ * frequency*k/65536 with k the line time in us * 2^32/10^6, which stays in
+ * 32 bits up to the Nyquist frequency.
+ */
+uint16_t audio_step(unsigned int frequency) {
+	uint32_t k = display.lines_frame == _NTSC_LINE_FRAME ?
+		(uint32_t)(_NTSC_TIME_SCANLINE * 4294.967296 + 0.5) :
+		(uint32_t)(_PAL_TIME_SCANLINE * 4294.967296 + 0.5);
+
+	if (frequency > 7800)
+		frequency = 7800;
+	return (frequency * k + 32768) >> 16;
+}
+
+void TVoutAudio::frequency(uint8_t voice, unsigned int frequency) {
+	uint16_t step;
+
+	if (voice >= AUDIO_VOICES)
+		return;
+	step = audio_step(frequency);
+	uint8_t sreg = SREG;
+	cli();
+	audio_voices[voice].step = step;
+	SREG = sreg;
+}
+
+void TVoutAudio::volume(uint8_t voice, uint8_t volume) {
+	if (voice < AUDIO_VOICES)
+		audio_voices[voice].volume = volume / 3;
+}
+
+void TVoutAudio::waveform(uint8_t voice, uint8_t wave) {
+	if (voice < AUDIO_VOICES)
+		audio_voices[voice].wave = (wave & 7) * 32;
+}
+
+void TVoutAudio::waveforms(const int8_t * b) {
+	bank = (uint16_t)b >> 8;
+}
+
+void TVoutAudio::off(uint8_t voice) {
+	if (voice < AUDIO_VOICES)
+		audio_voices[voice].volume = 0;
+}
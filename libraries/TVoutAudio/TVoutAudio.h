@@ -0,0 +1,194 @@
+/*
+ TVoutAudio - multi voice wavetable sound for TVout.
+
+ Three voices, each a 16 bit phase accumulator stepping through a 32 sample
+ waveform, are mixed once per scan line (15734 Hz NTSC, 15625 Hz PAL) from
+ the TVout hbi hook. The sum drives OC2A, the TVout sound pin, as an 8 bit
+ fast PWM at 62.5 kHz, so put a simple RC low pass (1k, 100nF) before the
+ amplifier. Timer 2 belongs to the mixer between begin() and end(), and
+ TV.tone(), TV.noTone() and TV.play() do nothing meanwhile. TVoutPCM.h
+ plays recorded samples on the same pin, in place of the voices.
+
+ Waveforms are signed 32 sample tables, 8 of them in a 256 byte aligned
+ PROGMEM bank; the built in bank has the WAVE_ shapes below. A voice at full
+ volume swings a third of the output range, so three voices never clip.
+
+ Cycle budget. The hook runs inside ISR(TIMER1_OVF_vect) ahead of
+ active_line, whose wait_until(display.output_delay) must read TCNT1 before
+ output_delay - 10, cycle 181 on NTSC and 189 on PAL, or the line is drawn
+ late. Counted from the instruction timings, cycles after the overflow:
+	interrupt response and vector jump		  7
+	ISR prologue, saving the call used registers	 32
+	calling the hook				  7
+	audio_mix(): setup 3, per voice 29, output 3	 93
+	return, calling active_line, reading TCNT1	~20
+ which reads TCNT1 near cycle 160, with about 20 cycles to spare on NTSC for
+ instructions in progress when the line starts. Keep the interrupts enabled
+ in the sketch: a cli() section delays the line and eats into that margin.
+ This is why the voice count is fixed at 3 and the mixer is written in
+ assembler with no per voice branches. Chained with other hooks by
+ TV.add_hbi_hook() the walk alone takes more than that margin, so on NTSC
+ keep the mixer the only hbi hook and poll the rest from the vbi hooks.
+
+ Songs. play() plays a song in the tracker format below on the voices,
+ stepped once per frame from the hook returned by frame_hook(), installed
+ with TV.set_vbi_hook(). extra/mid2song.cpp converts MIDI files. A song is
+ a list of orders, each naming a pattern per voice, and every pattern is a
+ byte code list of the rows of one voice:
+	row ms lo, row ms hi	length of a row in ms
+	rows			rows per pattern, 1-255
+	orders			number of orders
+	loop			order to go on with after the last, 255 to stop
+	patterns		number of patterns
+	order[orders][3]	pattern of each voice, 255 is silence
+	offset[patterns][2]	offset of each pattern from the start, lo hi
+	pattern data
+ Pattern bytes, built with the TRACK_ macros:
+	0x00-0x5F	note, MIDI note - 12, C0 to B7, for one row
+	0x60-0x67	waveform, from this row on
+	0x68		note off, for one row
+	0x70-0x7F	volume of the following notes, in 16 steps
+	0x80-0xFF	nothing new for 1 to 128 rows
+ The notes step from a table of the top octave shifted down, so a note
+ costs one byte and a sustained note or a rest a byte per 128 rows, where
+ TV.play() takes 4 bytes per note and per rest. Repeated patterns are
+ stored once.
+
+ Sound effects. sfx_play() starts an effect from the table given to
+ effects(), on one voice, by default the last. An effect is a script of
+ bytes built with the SFX_ macros, stepped once per frame with the song:
+	SFX_NOTE(midi), SFX_FREQ(hz)	pitch
+	SFX_WAVE(wave)			waveform, the pulses give the duty
+	SFX_VOLUME(vol)			volume, 0-255 in 16 steps
+	SFX_SWEEP(step)			added to the phase step every frame
+	SFX_FADE(vol)			added to the volume every frame, 0-85
+	SFX_FRAMES(n)			sound for n frames, 1-128
+	SFX_END
+ Sweep and fade hold until changed. An effect preempts one of the same or
+ lower priority and is refused by a higher one. Meanwhile the song goes on
+ playing the voice aside, and has it back when the effect ends, so the
+ sketch only makes the call.
+
+ Usage:
+	TVout TV;
+	TVoutAudio audio;
+
+	void setup() {
+		TV.begin(NTSC, 128, 96);
+		TV.set_hbi_hook(audio.begin());
+		TV.set_vbi_hook(audio.frame_hook());
+		audio.waveform(0, WAVE_TRIANGLE);
+		audio.note(0, 440, 255);
+		audio.play(song);
+		audio.effects(sfx);
+	}
+
+	PROGMEM const unsigned char laser[] = {
+		SFX_WAVE(WAVE_PULSE25), SFX_VOLUME(255), SFX_NOTE(96),
+		SFX_SWEEP(-300), SFX_FADE(-3), SFX_FRAMES(24), SFX_END
+	};
+	PROGMEM const unsigned char * const sfx[] = { laser };
+	...
+	audio.sfx_play(0, 1);
+*/
+
+#ifndef TVOUTAUDIO_H
+#define TVOUTAUDIO_H
+
+#include <stdint.h>
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+
+#define AUDIO_VOICES	3
+
+// waveforms of the built in bank
+#define WAVE_SQUARE		0
+#define WAVE_SAW		1
+#define WAVE_TRIANGLE	2
+#define WAVE_SINE		3
+#define WAVE_PULSE25	4
+#define WAVE_PULSE12	5
+#define WAVE_NOISE		6
+#define WAVE_ORGAN		7
+
+// song pattern bytes
+#define TRACK_NOTE(midi)	((midi) - 12)
+#define TRACK_WAVE(wave)	(0x60 | (wave))
+#define TRACK_OFF			0x68
+#define TRACK_VOLUME(vol)	(0x70 | (vol) >> 4)
+#define TRACK_WAIT(rows)	(0x80 | ((rows) - 1))
+#define TRACK_SILENT		0xFF
+
+// sound effect script bytes
+#define SFX_NOTE(midi)		TRACK_NOTE(midi)
+#define SFX_WAVE(wave)		TRACK_WAVE(wave)
+#define SFX_VOLUME(vol)		TRACK_VOLUME(vol)
+#define SFX_SWEEP(step)		0x68, (uint8_t)(step), (uint8_t)((uint16_t)(step) >> 8)
+#define SFX_FADE(vol)		0x69, (uint8_t)(vol)
+#define SFX_FREQ(hz)		0x6A, (uint8_t)(hz), (uint8_t)((hz) >> 8)
+#define SFX_FRAMES(n)		TRACK_WAIT(n)
+#define SFX_END				0x6F
+
+// declares a waveform bank for waveforms(): 8 waveforms of 32 signed samples
+#define AUDIO_WAVES(name)	PROGMEM const int8_t name[256] __attribute__((aligned(256)))
+
+//define a void function() return type.
+typedef void (*pt2Funct)();
+
+// one voice as the mixer reads it, the layout is fixed by audio_mix()
+struct audio_voice {
+	uint16_t phase;
+	uint16_t step;		// phase increment per line
+	uint8_t wave;		// offset of the waveform in the bank, 32 per waveform
+	uint8_t volume;		// 0-85, a third of the output range
+};
+
+class TVoutAudio {
+public:
+	// Sets up timer 2 for PWM, TV.begin() has to be called first.
+	// Returns the hook to pass to TV.set_hbi_hook().
+	pt2Funct begin();
+	// Silences the voices and releases timer 2.
+	void end();
+	// Plays frequency Hz (up to half the line rate) on a voice, volume 0-255.
+	void note(uint8_t voice, unsigned int frequency, uint8_t volume = 255);
+	// Changes the frequency of a voice, keeping its phase.
+	void frequency(uint8_t voice, unsigned int frequency);
+	// Changes the volume of a voice, 0 silences it.
+	void volume(uint8_t voice, uint8_t volume);
+	// Selects one of the 8 waveforms of the bank for a voice.
+	void waveform(uint8_t voice, uint8_t wave);
+	// Switches to another waveform bank, declared with AUDIO_WAVES().
+	void waveforms(const int8_t * bank);
+	// Silences a voice.
+	void off(uint8_t voice);
+	// Returns the hook to pass to TV.set_vbi_hook(), which steps songs and effects.
+	pt2Funct frame_hook();
+	// Plays a song from the start, replacing the one playing.
+	void play(const unsigned char * song);
+	// Stops the song and silences the voices.
+	void stop();
+	// 1 while a song plays.
+	char is_playing();
+	// Sets the effect table, PROGMEM pointers to scripts, and the voice
+	// effects play on.
+	void effects(const unsigned char * const * table, uint8_t voice = AUDIO_VOICES - 1);
+	// Plays effect id of the table unless one of higher priority plays.
+	// Returns 0 when refused.
+	char sfx_play(uint8_t id, uint8_t priority = 0);
+	// Ends the effect, the voice goes back to the song.
+	void sfx_stop();
+	// 1 while an effect plays.
+	char sfx_playing();
+};
+
+extern AUDIO_WAVES(audio_waves);
+extern struct audio_voice audio_voices[AUDIO_VOICES];
+
+void audio_mix();
+void audio_frame();
+void audio_pwm_begin();
+void audio_pwm_end();
+uint16_t audio_step(unsigned int frequency);
+
+#endif
@@ -0,0 +1,137 @@
+#include "TVoutPCM.h"
+#include <avr/interrupt.h>
+#include <TVout.h>
+
+// ADPCM step sizes and step index changes by code magnitude, extra/wav2pcm.cpp
+// encodes with the same tables. In RAM, they are read every sample.
+static const uint8_t pcm_steps[16] = { 1, 2, 3, 4, 5, 6, 8, 10, 13, 16, 20, 25, 32, 40, 50, 64 };
+static const int8_t pcm_adapt[8] = { -1, -1, -1, -1, 2, 4, 6, 8 };
+
+static const unsigned char * volatile pcm_queue[PCM_QUEUE];
+static volatile uint8_t pcm_loops;		// loop flag of every queue entry
+static volatile uint8_t pcm_head, pcm_tail;
+
+static const unsigned char * pcm_sample;	// sound playing, 0 when idle
+static const unsigned char * pcm_ptr;
+static uint16_t pcm_left;				// samples left in this pass
+static uint8_t pcm_format, pcm_loop;
+static uint8_t pcm_byte, pcm_value, pcm_index;	// ADPCM decoder state
+
+// the line after a sound ended: the next one in the queue, the loop again or silence
+static void pcm_start() {
+	const unsigned char * s;
+
+	if (pcm_head != pcm_tail) {
+		s = pcm_queue[pcm_tail];
+		pcm_loop = pcm_loops & _BV(pcm_tail);
+		pcm_tail = (pcm_tail + 1) & (PCM_QUEUE - 1);
+	}
+	else if (pcm_loop && pcm_sample)
+		s = pcm_sample;
+	else {
+		if (pcm_sample) {
+			pcm_sample = 0;
+			OCR2A = 0x80;
+		}
+		return;
+	}
+	pcm_sample = s;
+	pcm_format = pgm_read_byte(s);
+	pcm_left = pgm_read_word(s + 1);
+	pcm_ptr = s + 3;
+	pcm_value = 0x80;
+	pcm_index = 0;
+}
+
+// hbi hook: one sample per line
+void pcm_line() {
+	uint8_t v, code, m;
+	int16_t t;
+	int8_t i;
+
+	if (!pcm_left) {
+		pcm_start();
+		return;
+	}
+	if (pcm_format == PCM_8BIT)
+		v = pgm_read_byte(pcm_ptr++);
+	else {
+		// two samples a byte, high nibble first, the sample count is even
+		if (pcm_left & 1)
+			code = pcm_byte & 0x0F;
+		else {
+			pcm_byte = pgm_read_byte(pcm_ptr++);
+			code = pcm_byte >> 4;
+		}
+		m = code & 7;
+		t = ((m*2 + 1) * pcm_steps[pcm_index]) >> 1;
+		if (code & 8) {
+			t = pcm_value - t;
+			if (t < 0)
+				t = 0;
+		}
+		else {
+			t = pcm_value + t;
+			if (t > 255)
+				t = 255;
+		}
+		pcm_value = v = t;
+		i = pcm_index + pcm_adapt[m];
+		if (i < 0)
+			i = 0;
+		else if (i > 15)
+			i = 15;
+		pcm_index = i;
+	}
+	OCR2A = v;
+	pcm_left--;
+}
+
+pt2Funct TVoutPCM::begin() {
+	stop();
+	audio_pwm_begin();
+	return &pcm_line;
+}
+
+void TVoutPCM::end() {
+	stop();
+	audio_pwm_end();
+}
+
+char TVoutPCM::play(const unsigned char * sample, char loop) {
+	uint8_t head = pcm_head, next = (head + 1) & (PCM_QUEUE - 1);
+
+	if (next == pcm_tail)
+		return 0;
+	pcm_queue[head] = sample;
+	if (loop)
+		pcm_loops |= _BV(head);
+	else
+		pcm_loops &= ~_BV(head);
+	pcm_head = next;
+	return 1;
+}
+
+void TVoutPCM::stop() {
+	uint8_t sreg = SREG;
+	cli();
+	pcm_tail = pcm_head;
+	pcm_left = 0;
+	pcm_sample = 0;
+	pcm_loop = 0;
+	SREG = sreg;
+	OCR2A = 0x80;
+}
+
+char TVoutPCM::is_playing() {
+	char playing;
+	uint8_t sreg = SREG;
+	cli();
+	playing = pcm_sample || pcm_head != pcm_tail;
+	SREG = sreg;
+	return playing;
+}
+
+uint8_t TVoutPCM::queued() {
+	return (pcm_head - pcm_tail) & (PCM_QUEUE - 1);
+}
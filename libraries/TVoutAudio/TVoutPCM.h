@@ -0,0 +1,70 @@
+/*
+ TVoutPCM - sample playback for TVout.
+
+ Plays sounds from PROGMEM, one sample per scan line from the TVout hbi
+ hook, on the same PWM output as TVoutAudio: 15736 samples per second on
+ NTSC, 15625 on PAL. extra/wav2pcm.cpp converts WAV files at these rates to
+ 8 bit PCM or 4 bit ADPCM, which holds twice as long a sound in the same
+ flash.
+
+ Sounds wait in a queue of PCM_QUEUE and play back to back. A looping sound
+ repeats until another one is queued, which then starts at the end of the
+ current pass, so a loop can run under one shot effects queued on top.
+
+ The hook either outputs one sample or, on the line after a sound ends,
+ starts the next one. Both are short straight C code, the ADPCM sample
+ being the longest at about 70 cycles, inside the budget worked out in
+ TVoutAudio.h. TVoutPCM and TVoutAudio both drive timer 2 from the single
+ hbi hook, use one of them at a time. TV.tone() and TV.play() do nothing
+ between begin() and end().
+
+ Usage:
+	#include "laser.h"	// from wav2pcm laser.wav
+
+	TVout TV;
+	TVoutPCM pcm;
+
+	void setup() {
+		TV.begin(NTSC, 128, 96);
+		TV.set_hbi_hook(pcm.begin());
+	}
+
+	void loop() {
+		if (fire)
+			pcm.play(laser);
+	}
+*/
+
+#ifndef TVOUTPCM_H
+#define TVOUTPCM_H
+
+#include "TVoutAudio.h"
+
+// sample formats, the first byte of a sample
+#define PCM_8BIT	1
+#define PCM_ADPCM	2
+
+// sounds waiting to play, a power of 2
+#define PCM_QUEUE	4
+
+class TVoutPCM {
+public:
+	// Sets up timer 2 for PWM, TV.begin() has to be called first.
+	// Returns the hook to pass to TV.set_hbi_hook().
+	pt2Funct begin();
+	// Stops playing and releases timer 2.
+	void end();
+	// Queues a sound, looping until the next one is queued if loop is set.
+	// Returns 0 when the queue is full.
+	char play(const unsigned char * sample, char loop = 0);
+	// Stops the sound playing and drops the queue.
+	void stop();
+	// 1 while a sound plays or waits in the queue.
+	char is_playing();
+	// Number of sounds waiting in the queue.
+	uint8_t queued();
+};
+
+void pcm_line();
+
+#endif
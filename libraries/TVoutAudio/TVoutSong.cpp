@@ -0,0 +1,268 @@
+#include "TVoutAudio.h"
+#include <avr/interrupt.h>
+#include <TVout.h>
+
+// phase steps of C7 to B7, lower octaves shift them down
+#define TRACK_STEP(f, line_us)	(uint16_t)((f) * (line_us) * 0.065536 + 0.5)
+#define TRACK_OCTAVE(line_us) { \
+	TRACK_STEP(2093.005, line_us), TRACK_STEP(2217.461, line_us), TRACK_STEP(2349.318, line_us), \
+	TRACK_STEP(2489.016, line_us), TRACK_STEP(2637.020, line_us), TRACK_STEP(2793.826, line_us), \
+	TRACK_STEP(2959.955, line_us), TRACK_STEP(3135.963, line_us), TRACK_STEP(3322.438, line_us), \
+	TRACK_STEP(3520.000, line_us), TRACK_STEP(3729.310, line_us), TRACK_STEP(3951.066, line_us) }
+
+PROGMEM static const uint16_t track_steps[2][12] = {
+	TRACK_OCTAVE(_NTSC_TIME_SCANLINE),
+	TRACK_OCTAVE(_PAL_TIME_SCANLINE)
+};
+
+static const unsigned char * volatile track_song;
+static const unsigned char * track_ptr[AUDIO_VOICES];	// 0 for a silent voice
+static uint8_t track_wait[AUDIO_VOICES];			// rows before the next event
+static uint8_t track_volume[AUDIO_VOICES];
+static uint8_t track_order, track_row;
+static long track_left;						// us left of the current row
+
+static const unsigned char * const * sfx_table;
+static const unsigned char * volatile sfx_ptr;	// effect playing, 0 for none
+static struct audio_voice sfx_held;		// the song on the effect voice meanwhile
+static uint8_t sfx_voice = AUDIO_VOICES - 1;
+static uint8_t sfx_priority, sfx_wait;
+static int16_t sfx_sweep;
+static int8_t sfx_fade;
+
+// where the song plays a voice, aside while an effect has it
+static struct audio_voice * track_voice(uint8_t v) {
+	return v == sfx_voice && sfx_ptr ? &sfx_held : &audio_voices[v];
+}
+
+// phase step of a note, MIDI note - 12
+static uint16_t track_step(uint8_t note) {
+	const uint16_t * steps = track_steps[display.lines_frame != _NTSC_LINE_FRAME];
+	uint8_t shift;
+
+	for (shift = 7; note >= 12; shift--)
+		note -= 12;
+	return pgm_read_word(steps + note) >> shift;
+}
+
+static void track_silence() {
+	for (uint8_t v = 0; v < AUDIO_VOICES; v++)
+		track_voice(v)->volume = 0;
+}
+
+// events of a voice up to the next one that takes a row
+static void track_event(uint8_t v) {
+	const unsigned char * p = track_ptr[v];
+	struct audio_voice * out = track_voice(v);
+	uint8_t c;
+
+	for (;;) {
+		c = pgm_read_byte(p++);
+		if (c < 0x60) {
+			out->step = track_step(c);
+			out->volume = track_volume[v];
+			break;
+		}
+		else if (c < 0x68)
+			out->wave = (c & 7) * 32;
+		else if (c >= 0x80) {
+			track_wait[v] = c & 0x7F;
+			break;
+		}
+		else if (c >= 0x70)
+			track_volume[v] = (c & 0x0F) * 17 / 3;
+		else {
+			out->volume = 0;
+			break;
+		}
+	}
+	track_ptr[v] = p;
+}
+
+// the next row, 0 at the end of the song
+static char track_next_row() {
+	const unsigned char * song = track_song;
+	uint8_t v, pattern;
+
+	if (track_row == 0) {
+		if (track_order == pgm_read_byte(song + 3)) {
+			track_order = pgm_read_byte(song + 4);
+			if (track_order == 255)
+				return 0;
+		}
+		for (v = 0; v < AUDIO_VOICES; v++) {
+			pattern = pgm_read_byte(song + 6 + track_order * AUDIO_VOICES + v);
+			track_wait[v] = 0;
+			if (pattern == TRACK_SILENT) {
+				track_ptr[v] = 0;
+				track_voice(v)->volume = 0;
+			}
+			else
+				track_ptr[v] = song + pgm_read_word(song + 6 +
+					pgm_read_byte(song + 3) * AUDIO_VOICES + pattern * 2);
+		}
+	}
+	for (v = 0; v < AUDIO_VOICES; v++) {
+		if (!track_ptr[v])
+			continue;
+		if (track_wait[v])
+			track_wait[v]--;
+		else
+			track_event(v);
+	}
+	if (++track_row == pgm_read_byte(song + 2)) {
+		track_row = 0;
+		track_order++;
+	}
+	return 1;
+}
+
+// one frame of the song
+static void track_frame() {
+	while (track_left <= 0) {
+		if (!track_next_row()) {
+			track_song = 0;
+			track_silence();
+			return;
+		}
+		track_left += pgm_read_word(track_song) * 1000L;
+	}
+	if (display.lines_frame == _NTSC_LINE_FRAME)
+		track_left -= _NTSC_TIME_FRAME;
+	else
+		track_left -= _PAL_TIME_FRAME;
+}
+
+/* One frame of the effect: the sweep and the fade of the current step, or
+ * the script up to the next step. At the end the voice gets back the song.
+ */
+static void sfx_frame() {
+	const unsigned char * p = sfx_ptr;
+	struct audio_voice * out = &audio_voices[sfx_voice];
+	long step;
+	int16_t t;
+	uint8_t c;
+
+	if (sfx_wait) {
+		sfx_wait--;
+		step = (long)out->step + sfx_sweep;
+		out->step = step < 0 ? 0 : step > 0x7FFF ? 0x7FFF : step;
+		t = out->volume + sfx_fade;
+		out->volume = t < 0 ? 0 : t > 85 ? 85 : t;
+		return;
+	}
+	for (;;) {
+		c = pgm_read_byte(p++);
+		if (c < 0x60)
+			out->step = track_step(c);
+		else if (c < 0x68)
+			out->wave = (c & 7) * 32;
+		else if (c >= 0x80) {
+			sfx_wait = c & 0x7F;
+			break;
+		}
+		else if (c >= 0x70)
+			out->volume = (c & 0x0F) * 17 / 3;
+		else if (c == 0x68) {
+			sfx_sweep = pgm_read_word(p);
+			p += 2;
+		}
+		else if (c == 0x69)
+			sfx_fade = pgm_read_byte(p++);
+		else if (c == 0x6A) {
+			out->step = audio_step(pgm_read_word(p));
+			p += 2;
+		}
+		else {
+			sfx_held.phase = out->phase;
+			*out = sfx_held;
+			sfx_ptr = 0;
+			return;
+		}
+	}
+	sfx_ptr = p;
+}
+
+/* vbi hook: advances the song and the effect by one frame. Like TV.play(),
+ * track_left keeps the time left of the row in us so the tempo holds over
+ * the song while rows start on frames.
+ */
+void audio_frame() {
+	if (track_song)
+		track_frame();
+	if (sfx_ptr)
+		sfx_frame();
+}
+
+pt2Funct TVoutAudio::frame_hook() {
+	return &audio_frame;
+}
+
+void TVoutAudio::play(const unsigned char * song) {
+	uint8_t sreg = SREG;
+	cli();
+	for (uint8_t v = 0; v < AUDIO_VOICES; v++)
+		track_volume[v] = 255 / 3;
+	track_order = 0;
+	track_row = 0;
+	// rows start on the frame closest to their time
+	if (display.lines_frame == _NTSC_LINE_FRAME)
+		track_left = -_NTSC_TIME_FRAME / 2;
+	else
+		track_left = -_PAL_TIME_FRAME / 2;
+	track_song = song;
+	SREG = sreg;
+}
+
+void TVoutAudio::stop() {
+	uint8_t sreg = SREG;
+	cli();
+	track_song = 0;
+	track_silence();
+	SREG = sreg;
+}
+
+char TVoutAudio::is_playing() {
+	return track_song != 0;
+}
+
+void TVoutAudio::effects(const unsigned char * const * table, uint8_t voice) {
+	sfx_stop();
+	sfx_table = table;
+	if (voice < AUDIO_VOICES)
+		sfx_voice = voice;
+}
+
+char TVoutAudio::sfx_play(uint8_t id, uint8_t priority) {
+	uint8_t sreg = SREG;
+	cli();
+	if (sfx_ptr && priority < sfx_priority) {
+		SREG = sreg;
+		return 0;
+	}
+	if (!sfx_ptr)
+		sfx_held = audio_voices[sfx_voice];
+	sfx_priority = priority;
+	sfx_wait = 0;
+	sfx_sweep = 0;
+	sfx_fade = 0;
+	sfx_ptr = (const unsigned char *)pgm_read_word(sfx_table + id);
+	SREG = sreg;
+	return 1;
+}
+
+void TVoutAudio::sfx_stop() {
+	uint8_t sreg = SREG;
+	cli();
+	if (sfx_ptr) {
+		// the phase runs on, the rest is the song's
+		sfx_held.phase = audio_voices[sfx_voice].phase;
+		audio_voices[sfx_voice] = sfx_held;
+		sfx_ptr = 0;
+	}
+	SREG = sreg;
+}
+
+char TVoutAudio::sfx_playing() {
+	return sfx_ptr != 0;
+}
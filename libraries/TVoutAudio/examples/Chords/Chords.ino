@@ -0,0 +1,41 @@
+// Three voice chords and a melody while the picture keeps running.
+// The sound comes out of the TVout sound pin, pin 11 on an Uno, as PWM:
+// feed it through 1k and 100nF to ground before the amplifier.
+#include <TVout.h>
+#include <TVoutAudio.h>
+#include <fontALL.h>
+
+TVout TV;
+TVoutAudio audio;
+
+// C, F, G and C major
+const unsigned int chords[4][2] = {
+  { 262, 330 }, { 349, 440 }, { 392, 494 }, { 262, 330 }
+};
+const unsigned int tune[8] = { 523, 587, 659, 698, 784, 698, 659, 587 };
+
+void setup() {
+  TV.begin(NTSC, 128, 96);
+  TV.select_font(font6x8);
+  TV.set_hbi_hook(audio.begin());
+  audio.waveform(0, WAVE_TRIANGLE);
+  audio.waveform(1, WAVE_TRIANGLE);
+  audio.waveform(2, WAVE_PULSE25);
+}
+
+void loop() {
+  static uint8_t step = 0;
+
+  // a new note every 15 frames, a new chord every 60
+  if (step % 4 == 0) {
+    audio.note(0, chords[step/4 % 4][0], 160);
+    audio.note(1, chords[step/4 % 4][1], 160);
+  }
+  audio.note(2, tune[step % 8], 255);
+  TV.clear_screen();
+  TV.print(0, 0, "TVoutAudio");
+  TV.print(0, 16, tune[step % 8]);
+  TV.print(" Hz");
+  step++;
+  TV.delay_frame(15);
+}
@@ -0,0 +1,68 @@
+// Sound effects over a song: a coin now and then, and an explosion that
+// cuts it short. Voice 2, left out of the song, plays the effects; with a
+// song using all 3 voices, the effect borrows the voice and gives it back.
+// The sound comes out of the TVout sound pin, pin 11 on an Uno, as PWM:
+// feed it through 1k and 100nF to ground before the amplifier.
+#include <TVout.h>
+#include <TVoutAudio.h>
+#include <fontALL.h>
+
+TVout TV;
+TVoutAudio audio;
+
+// 8 rows of 125 ms a pattern, the bass under two melody patterns, looping
+PROGMEM const unsigned char song[] = {
+  125, 0, 8, 2, 0, 3,
+  // orders: voice 0, 1, 2
+  0, 1, TRACK_SILENT,
+  0, 2, TRACK_SILENT,
+  // pattern offsets
+  18, 0, 28, 0, 36, 0,
+  // 0: bass
+  TRACK_WAVE(WAVE_TRIANGLE), TRACK_VOLUME(255),
+  TRACK_NOTE(36), TRACK_WAIT(1), TRACK_NOTE(43), TRACK_WAIT(1),
+  TRACK_NOTE(36), TRACK_WAIT(1), TRACK_NOTE(43), TRACK_OFF,
+  // 1: melody
+  TRACK_WAVE(WAVE_PULSE25), TRACK_VOLUME(160),
+  TRACK_NOTE(72), TRACK_WAIT(1), TRACK_NOTE(76), TRACK_WAIT(1), TRACK_NOTE(79), TRACK_WAIT(3),
+  // 2: melody answer
+  TRACK_WAVE(WAVE_PULSE25), TRACK_VOLUME(160),
+  TRACK_NOTE(77), TRACK_WAIT(1), TRACK_NOTE(76), TRACK_WAIT(1), TRACK_NOTE(74), TRACK_WAIT(3)
+};
+
+PROGMEM const unsigned char coin[] = {
+  SFX_WAVE(WAVE_SQUARE), SFX_VOLUME(200), SFX_FREQ(988), SFX_FRAMES(4),
+  SFX_FREQ(1319), SFX_FADE(-4), SFX_FRAMES(16), SFX_END
+};
+PROGMEM const unsigned char explosion[] = {
+  SFX_WAVE(WAVE_NOISE), SFX_VOLUME(255), SFX_NOTE(60),
+  SFX_SWEEP(-20), SFX_FADE(-2), SFX_FRAMES(40), SFX_END
+};
+PROGMEM const unsigned char * const effects[] = { coin, explosion };
+#define SFX_COIN      0
+#define SFX_EXPLOSION 1
+
+void setup() {
+  TV.begin(NTSC, 128, 96);
+  TV.select_font(font6x8);
+  TV.set_hbi_hook(audio.begin());
+  TV.set_vbi_hook(audio.frame_hook());
+  audio.effects(effects);
+  audio.play(song);
+}
+
+void loop() {
+  static unsigned int frame = 0;
+
+  // a coin never interrupts an explosion, an explosion always wins
+  if (frame % 45 == 0)
+    audio.sfx_play(SFX_COIN, 0);
+  if (frame % 240 == 100)
+    audio.sfx_play(SFX_EXPLOSION, 1);
+  TV.clear_screen();
+  TV.print(0, 0, "TVoutAudio effects");
+  if (audio.sfx_playing())
+    TV.print(0, 16, "sfx");
+  frame++;
+  TV.delay_frame(1);
+}
@@ -0,0 +1,28 @@
+// A three voice round played by the song player, while the sketch draws.
+// frere_jacques.cpp was made with extra/mid2song -L frere_jacques.mid.
+// The sound comes out of the TVout sound pin, pin 11 on an Uno, as PWM:
+// feed it through 1k and 100nF to ground before the amplifier.
+#include <TVout.h>
+#include <TVoutAudio.h>
+#include <fontALL.h>
+#include "frere_jacques.h"
+
+TVout TV;
+TVoutAudio audio;
+
+void setup() {
+  TV.begin(NTSC, 128, 96);
+  TV.select_font(font6x8);
+  TV.set_hbi_hook(audio.begin());
+  TV.set_vbi_hook(audio.frame_hook());
+  audio.play(frere_jacques);
+}
+
+void loop() {
+  // the voices as bars, the song runs on its own
+  TV.clear_screen();
+  TV.print(0, 0, "TVoutAudio song");
+  for (uint8_t v = 0; v < AUDIO_VOICES; v++)
+    TV.draw_rect(8 + v*40, 90 - audio_voices[v].volume, 24, audio_voices[v].volume, WHITE, WHITE);
+  TV.delay_frame(2);
+}
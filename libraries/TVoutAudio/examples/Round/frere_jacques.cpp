@@ -0,0 +1,20 @@
+// frere_jacques.mid, a round in 3 voices, 192 rows of 100 ms, 19.2 s
+// Generated by mid2song
+#include "frere_jacques.h"
+
+PROGMEM const unsigned char frere_jacques[] = {
+  100, 0, 16, 12, 0, 14, 0, 255, 255, 0, 255, 255, 1, 2, 255, 1,
+  2, 255, 3, 4, 5, 3, 4, 5, 6, 7, 8, 9, 10, 8, 11, 12,
+  255, 11, 12, 255, 13, 255, 255, 13, 255, 255, 70, 0, 80, 0, 88, 0,
+  98, 0, 112, 0, 120, 0, 130, 0, 138, 0, 152, 0, 160, 0, 172, 0,
+  186, 0, 198, 0, 212, 0, 100, 124, 60, 130, 62, 130, 64, 130, 60, 130,
+  100, 124, 64, 130, 65, 130, 67, 134, 98, 122, 48, 130, 50, 130, 52, 130,
+  48, 130, 100, 124, 67, 128, 69, 128, 67, 128, 65, 128, 64, 130, 60, 130,
+  98, 122, 52, 130, 53, 130, 55, 134, 98, 119, 36, 130, 38, 130, 40, 130,
+  36, 130, 100, 124, 60, 130, 55, 130, 60, 134, 98, 122, 55, 128, 57, 128,
+  55, 128, 53, 128, 52, 130, 48, 130, 98, 119, 40, 130, 41, 130, 43, 134,
+  100, 124, 60, 130, 122, 55, 128, 53, 128, 124, 60, 134, 98, 122, 55, 128,
+  57, 128, 124, 55, 130, 122, 52, 130, 48, 130, 100, 122, 48, 130, 119, 43,
+  128, 41, 128, 122, 48, 134, 98, 119, 43, 128, 45, 128, 122, 43, 130, 119,
+  40, 130, 36, 130, 100, 119, 36, 130, 31, 130, 36, 134,
+};
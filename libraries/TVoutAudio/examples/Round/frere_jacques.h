@@ -0,0 +1,8 @@
+#ifndef FRERE_JACQUES_H
+#define FRERE_JACQUES_H
+
+#include <avr/pgmspace.h>
+
+extern const unsigned char frere_jacques[];
+
+#endif
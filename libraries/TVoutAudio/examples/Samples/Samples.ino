@@ -0,0 +1,36 @@
+// An engine loop with a laser shot now and then, played with TVoutPCM.
+// laser.cpp and engine.cpp were made with extra/wav2pcm -a -N.
+// The sound comes out of the TVout sound pin, pin 11 on an Uno, as PWM:
+// feed it through 1k and 100nF to ground before the amplifier.
+#include <TVout.h>
+#include <TVoutPCM.h>
+#include <fontALL.h>
+#include "laser.h"
+#include "engine.h"
+
+TVout TV;
+TVoutPCM pcm;
+
+void setup() {
+  TV.begin(NTSC, 128, 96);
+  TV.select_font(font6x8);
+  TV.set_hbi_hook(pcm.begin());
+  pcm.play(engine, 1);
+}
+
+void loop() {
+  static unsigned int shots = 0;
+
+  // the shot starts when the engine loop ends its pass, the engine
+  // queued after it goes on looping when the shot is over
+  if (pcm.queued() == 0) {
+    pcm.play(laser);
+    pcm.play(engine, 1);
+    shots++;
+  }
+  TV.clear_screen();
+  TV.print(0, 0, "TVoutPCM");
+  TV.print(0, 16, shots);
+  TV.print(" shots");
+  TV.delay_frame(120);
+}
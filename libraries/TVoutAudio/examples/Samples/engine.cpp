@@ -0,0 +1,106 @@
+// engine.wav, 4 bit ADPCM at 15736 Hz, 0.20 s
+// Generated by wav2pcm
+#include "engine.h"
+
+PROGMEM const unsigned char engine[] = {
+  2, 76, 12,
+  0, 16, 33, 3, 48, 51, 51, 195, 27, 64, 49, 19, 72, 104, 1, 161,
+  41, 176, 209, 153, 193, 140, 41, 177, 29, 139, 64, 170, 72, 139, 148, 184,
+  90, 40, 157, 138, 58, 192, 163, 45, 152, 34, 155, 181, 176, 43, 104, 129,
+  147, 169, 181, 145, 28, 60, 130, 148, 144, 74, 2, 193, 195, 10, 20, 141,
+  24, 17, 225, 136, 136, 43, 36, 147, 76, 3, 156, 33, 162, 145, 202, 50,
+  149, 152, 32, 90, 11, 66, 153, 89, 138, 80, 10, 59, 156, 43, 80, 179,
+  132, 132, 169, 132, 163, 25, 192, 104, 145, 8, 138, 46, 1, 145, 139, 149,
+  27, 18, 217, 1, 163, 80, 11, 59, 60, 74, 147, 13, 9, 20, 128, 173,
+  130, 156, 73, 0, 168, 194, 13, 9, 34, 208, 163, 9, 74, 25, 195, 30,
+  137, 58, 58, 32, 181, 129, 155, 209, 10, 89, 8, 19, 217, 115, 8, 128,
+  136, 153, 4, 169, 189, 26, 152, 4, 200, 137, 148, 140, 145, 201, 162, 224,
+  136, 177, 172, 139, 60, 1, 216, 169, 65, 160, 13, 8, 180, 153, 18, 88,
+  26, 1, 154, 36, 0, 172, 150, 136, 25, 131, 164, 164, 27, 74, 32, 196,
+  162, 163, 61, 8, 5, 144, 43, 20, 164, 137, 19, 4, 168, 194, 10, 72,
+  193, 138, 67, 208, 41, 144, 187, 64, 194, 11, 88, 16, 210, 178, 128, 171,
+  173, 25, 2, 91, 59, 12, 20, 128, 165, 11, 56, 209, 160, 4, 8, 72,
+  163, 149, 139, 73, 26, 29, 17, 184, 89, 2, 194, 27, 192, 132, 61, 129,
+  0, 144, 77, 0, 128, 132, 160, 6, 136, 26, 33, 22, 128, 138, 19, 186,
+  150, 145, 138, 19, 173, 27, 58, 6, 136, 42, 44, 58, 17, 44, 130, 153,
+  91, 32, 163, 89, 147, 209, 152, 50, 187, 182, 133, 41, 9, 10, 136, 232,
+  8, 144, 201, 137, 158, 136, 138, 57, 170, 193, 161, 177, 91, 16, 209, 25,
+  28, 32, 194, 13, 24, 128, 53, 10, 16, 80, 136, 50, 210, 10, 73, 16,
+  225, 0, 144, 59, 225, 144, 18, 156, 130, 154, 64, 3, 105, 1, 8, 177,
+  224, 130, 136, 194, 12, 131, 193, 44, 11, 60, 75, 16, 153, 208, 40, 180,
+  147, 193, 128, 185, 9, 162, 90, 9, 20, 162, 13, 1, 147, 203, 33, 0,
+  149, 136, 128, 240, 129, 152, 59, 3, 153, 0, 216, 0, 177, 80, 3, 180,
+  168, 11, 55, 128, 129, 177, 131, 181, 161, 26, 61, 42, 42, 29, 2, 153,
+  195, 192, 3, 203, 13, 17, 29, 2, 155, 52, 140, 4, 138, 133, 137, 8,
+  72, 144, 185, 10, 88, 27, 6, 145, 25, 145, 187, 73, 74, 34, 192, 192,
+  0, 186, 66, 193, 26, 177, 148, 167, 186, 9, 0, 26, 144, 169, 74, 49,
+  45, 130, 133, 162, 152, 36, 57, 60, 26, 67, 4, 132, 24, 58, 208, 24,
+  44, 64, 27, 44, 64, 146, 148, 73, 130, 172, 74, 20, 145, 10, 3, 147,
+  200, 141, 41, 40, 194, 201, 2, 176, 89, 25, 13, 144, 43, 194, 33, 219,
+  48, 129, 202, 21, 179, 154, 52, 148, 155, 120, 128, 136, 42, 18, 208, 178,
+  140, 3, 48, 200, 12, 8, 33, 176, 2, 0, 209, 0, 190, 1, 8, 140,
+  33, 28, 144, 149, 136, 43, 64, 193, 163, 13, 40, 153, 33, 209, 139, 65,
+  142, 1, 162, 137, 74, 24, 176, 37, 152, 58, 155, 165, 43, 8, 61, 2,
+  177, 28, 11, 64, 48, 74, 173, 24, 21, 176, 58, 194, 176, 49, 74, 49,
+  160, 189, 17, 179, 195, 192, 178, 72, 75, 40, 88, 162, 155, 32, 96, 128,
+  161, 72, 172, 72, 1, 252, 128, 128, 16, 129, 128, 49, 96, 2, 16, 180,
+  80, 147, 131, 131, 193, 45, 58, 33, 28, 72, 162, 58, 195, 18, 176, 73,
+  138, 194, 170, 42, 66, 187, 181, 0, 192, 138, 89, 129, 24, 14, 137, 17,
+  208, 0, 163, 172, 148, 161, 12, 28, 0, 29, 1, 176, 187, 65, 13, 144,
+  42, 192, 73, 28, 1, 194, 24, 202, 5, 128, 61, 130, 180, 144, 129, 225,
+  136, 162, 29, 41, 1, 200, 147, 181, 10, 89, 42, 8, 60, 129, 148, 192,
+  58, 144, 96, 153, 73, 9, 60, 145, 25, 194, 10, 17, 178, 147, 195, 161,
+  200, 10, 12, 24, 66, 193, 178, 164, 13, 1, 144, 89, 26, 147, 12, 26,
+  149, 24, 178, 35, 91, 16, 137, 200, 88, 144, 129, 104, 128, 146, 141, 17,
+  160, 200, 44, 59, 216, 57, 139, 209, 136, 140, 131, 41, 210, 178, 17, 148,
+  141, 1, 145, 133, 8, 37, 129, 73, 25, 52, 136, 59, 89, 4, 177, 24,
+  195, 172, 42, 185, 59, 2, 12, 168, 73, 164, 11, 11, 201, 195, 13, 8,
+  160, 89, 145, 176, 60, 184, 196, 153, 24, 59, 208, 138, 163, 36, 179, 208,
+  27, 3, 32, 208, 129, 12, 3, 176, 211, 168, 0, 216, 57, 195, 156, 33,
+  27, 202, 64, 146, 60, 139, 88, 2, 11, 4, 28, 147, 140, 16, 9, 38,
+  10, 17, 160, 3, 216, 2, 155, 225, 163, 160, 158, 0, 1, 12, 43, 49,
+  224, 10, 130, 75, 128, 164, 57, 224, 161, 43, 3, 75, 148, 59, 21, 152,
+  150, 136, 136, 74, 8, 16, 225, 136, 128, 196, 153, 131, 153, 185, 81, 138,
+  132, 27, 209, 148, 128, 139, 25, 30, 2, 153, 129, 208, 132, 144, 12, 25,
+  72, 42, 202, 73, 40, 26, 58, 200, 20, 178, 195, 137, 75, 105, 0, 31,
+  51, 145, 152, 129, 152, 194, 168, 192, 192, 189, 0, 139, 9, 172, 184, 90,
+  154, 61, 136, 26, 200, 173, 145, 180, 178, 141, 146, 157, 24, 152, 60, 178,
+  60, 60, 146, 209, 145, 44, 131, 161, 67, 201, 59, 66, 170, 226, 144, 16,
+  194, 178, 88, 42, 29, 130, 176, 81, 136, 72, 180, 9, 172, 19, 12, 73,
+  152, 19, 28, 41, 65, 170, 42, 64, 177, 49, 209, 12, 41, 12, 3, 181,
+  144, 24, 193, 148, 192, 33, 171, 2, 208, 27, 11, 156, 34, 209, 155, 89,
+  25, 40, 65, 171, 196, 161, 146, 192, 75, 146, 210, 178, 64, 193, 128, 3,
+  172, 147, 208, 8, 163, 58, 209, 138, 20, 148, 164, 10, 0, 156, 2, 88,
+  162, 133, 161, 61, 147, 137, 10, 49, 195, 189, 25, 57, 217, 32, 193, 180,
+  26, 59, 29, 146, 0, 178, 88, 161, 162, 72, 155, 73, 66, 243, 9, 8,
+  138, 140, 26, 170, 240, 152, 8, 140, 128, 24, 232, 138, 18, 173, 1, 176,
+  200, 17, 45, 41, 182, 128, 144, 32, 186, 35, 147, 19, 147, 52, 41, 59,
+  208, 35, 185, 89, 2, 60, 132, 161, 60, 2, 194, 189, 24, 57, 163, 65,
+  139, 2, 174, 25, 9, 132, 128, 193, 40, 75, 26, 209, 136, 59, 187, 11,
+  164, 27, 193, 58, 154, 225, 144, 12, 42, 42, 104, 10, 58, 132, 178, 41,
+  210, 130, 173, 144, 1, 0, 105, 24, 145, 6, 146, 152, 11, 147, 147, 61,
+  128, 42, 225, 152, 2, 193, 20, 184, 44, 60, 44, 17, 177, 179, 156, 3,
+  192, 75, 6, 137, 41, 41, 139, 29, 131, 155, 161, 45, 41, 132, 152, 150,
+  144, 131, 177, 90, 32, 209, 138, 34, 193, 41, 216, 8, 132, 178, 163, 189,
+  18, 178, 46, 25, 10, 132, 12, 58, 179, 209, 31, 168, 128, 136, 27, 32,
+  177, 178, 54, 136, 26, 133, 136, 58, 52, 25, 88, 133, 129, 152, 32, 52,
+  2, 64, 165, 2, 147, 155, 80, 18, 154, 44, 49, 33, 225, 152, 58, 129,
+  193, 43, 224, 16, 155, 57, 58, 89, 146, 129, 196, 168, 133, 137, 128, 53,
+  177, 9, 172, 147, 90, 3, 155, 0, 200, 195, 176, 74, 44, 56, 217, 136,
+  25, 36, 10, 194, 148, 179, 12, 56, 216, 0, 1, 1, 189, 131, 200, 9,
+  51, 153, 156, 40, 104, 9, 16, 208, 16, 161, 3, 5, 145, 161, 209, 163,
+  166, 129, 179, 168, 162, 3, 73, 160, 88, 130, 144, 51, 75, 147, 36, 194,
+  161, 13, 16, 163, 201, 74, 1, 27, 147, 89, 24, 11, 208, 24, 138, 194,
+  156, 131, 74, 5, 144, 10, 208, 133, 145, 128, 148, 169, 73, 163, 20, 178,
+  36, 163, 182, 152, 59, 145, 68, 182, 202, 8, 24, 24, 16, 133, 17, 131,
+  75, 52, 130, 59, 37, 3, 1, 28, 50, 240, 26, 17, 2, 164, 163, 18,
+  35, 75, 58, 210, 177, 29, 41, 139, 80, 145, 144, 209, 140, 136, 5, 144,
+  8, 179, 209, 178, 142, 9, 24, 148, 176, 156, 0, 89, 2, 192, 178, 38,
+  129, 193, 136, 25, 172, 57, 180, 129, 90, 41, 20, 155, 36, 195, 8, 160,
+  26, 13, 40, 10, 145, 53, 160, 57, 2, 193, 209, 1, 162, 164, 178, 195,
+  190, 25, 129, 152, 65, 165, 9, 144, 80, 139, 37, 136, 49, 203, 34, 193,
+  164, 128, 216, 130, 164, 61, 128, 128, 73, 16, 155, 177, 90, 3, 165, 144,
+  28, 3, 172, 74, 130, 164, 179, 73, 146, 60, 3, 176, 177, 44, 43, 2,
+  178, 188, 3, 193, 29, 147, 168, 179, 154, 52, 163, 33, 201, 2, 48, 26,
+  180, 136, 145, 0, 25, 0,
+};
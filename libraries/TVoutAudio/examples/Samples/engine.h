@@ -0,0 +1,8 @@
+#ifndef ENGINE_H
+#define ENGINE_H
+
+#include <avr/pgmspace.h>
+
+extern const unsigned char engine[];
+
+#endif
@@ -0,0 +1,130 @@
+// laser.wav, 4 bit ADPCM at 15736 Hz, 0.25 s
+// Generated by wav2pcm
+#include "laser.h"
+
+PROGMEM const unsigned char laser[] = {
+  2, 94, 15,
+  51, 203, 182, 49, 204, 131, 80, 188, 4, 16, 248, 3, 129, 217, 131, 72,
+  204, 3, 25, 232, 19, 11, 240, 148, 72, 185, 22, 9, 189, 19, 148, 185,
+  6, 72, 184, 22, 132, 169, 4, 72, 184, 7, 129, 186, 134, 24, 186, 23,
+  0, 171, 133, 40, 201, 0, 96, 155, 131, 120, 12, 192, 48, 143, 12, 34,
+  140, 144, 6, 9, 184, 55, 128, 204, 3, 8, 240, 194, 20, 169, 0, 120,
+  140, 9, 64, 12, 136, 36, 137, 192, 133, 8, 192, 147, 32, 233, 0, 64,
+  141, 12, 33, 140, 136, 22, 136, 192, 132, 0, 200, 130, 48, 204, 25, 104,
+  26, 185, 83, 145, 248, 4, 129, 172, 8, 80, 140, 8, 37, 128, 200, 3,
+  130, 233, 8, 80, 140, 9, 52, 136, 200, 5, 128, 171, 28, 120, 10, 184,
+  97, 128, 224, 146, 72, 13, 136, 35, 12, 193, 149, 4, 155, 28, 49, 137,
+  232, 19, 148, 200, 129, 72, 28, 144, 135, 128, 156, 8, 80, 140, 8, 35,
+  150, 176, 129, 104, 12, 128, 4, 132, 169, 0, 120, 10, 177, 227, 128, 158,
+  8, 64, 136, 192, 148, 24, 142, 8, 35, 150, 176, 130, 72, 14, 128, 4,
+  132, 169, 0, 80, 128, 200, 129, 104, 74, 144, 7, 128, 171, 30, 56, 10,
+  192, 134, 8, 28, 144, 135, 132, 154, 8, 80, 9, 192, 129, 64, 11, 208,
+  132, 0, 158, 8, 20, 128, 172, 8, 96, 128, 188, 24, 120, 10, 177, 148,
+  88, 74, 144, 5, 8, 12, 136, 22, 128, 186, 25, 69, 128, 185, 26, 97,
+  128, 200, 130, 72, 9, 240, 130, 40, 28, 208, 131, 25, 44, 208, 131, 24,
+  13, 160, 135, 8, 28, 144, 6, 128, 139, 162, 183, 24, 12, 128, 132, 24,
+  143, 8, 132, 25, 28, 161, 134, 8, 11, 161, 167, 24, 12, 128, 148, 41,
+  27, 240, 131, 25, 29, 160, 130, 96, 128, 200, 130, 72, 8, 232, 8, 50,
+  146, 249, 8, 64, 128, 188, 8, 55, 128, 140, 128, 133, 8, 27, 177, 164,
+  104, 10, 161, 148, 72, 9, 216, 8, 65, 128, 202, 9, 68, 128, 142, 128,
+  131, 41, 28, 208, 128, 104, 8, 185, 8, 83, 145, 204, 8, 6, 8, 11,
+  161, 167, 24, 8, 173, 8, 20, 8, 14, 128, 130, 57, 28, 208, 128, 64,
+  129, 248, 8, 3, 57, 31, 144, 129, 72, 8, 216, 8, 134, 8, 10, 177,
+  148, 88, 8, 200, 128, 7, 8, 11, 161, 150, 24, 0, 190, 8, 19, 136,
+  28, 208, 128, 64, 129, 217, 8, 4, 41, 28, 184, 8, 84, 128, 157, 128,
+  129, 80, 128, 216, 8, 4, 8, 28, 160, 9, 83, 145, 203, 128, 149, 72,
+  8, 159, 8, 4, 128, 136, 216, 8, 65, 136, 15, 128, 136, 65, 128, 141,
+  144, 148, 40, 0, 218, 8, 132, 88, 9, 184, 137, 84, 128, 10, 240, 128,
+  4, 128, 9, 240, 136, 20, 128, 141, 128, 128, 80, 128, 141, 128, 128, 80,
+  128, 141, 128, 128, 80, 128, 141, 128, 128, 80, 128, 141, 128, 128, 80, 128,
+  141, 128, 128, 80, 128, 141, 128, 128, 80, 128, 141, 128, 128, 80, 128, 141,
+  128, 136, 52, 8, 28, 208, 128, 21, 128, 137, 208, 128, 21, 128, 128, 201,
+  128, 133, 40, 129, 233, 8, 8, 112, 128, 140, 128, 136, 112, 128, 136, 208,
+  136, 22, 128, 136, 192, 128, 149, 24, 0, 191, 8, 8, 64, 8, 15, 128,
+  128, 6, 128, 136, 192, 128, 148, 56, 128, 206, 8, 8, 64, 8, 15, 128,
+  128, 135, 128, 128, 157, 8, 1, 72, 8, 30, 144, 128, 135, 8, 8, 185,
+  128, 149, 88, 8, 10, 208, 128, 134, 8, 8, 13, 128, 128, 64, 8, 28,
+  192, 128, 150, 24, 8, 14, 128, 136, 21, 128, 129, 189, 8, 8, 96, 128,
+  136, 208, 128, 130, 88, 8, 13, 144, 128, 7, 8, 8, 141, 8, 8, 51,
+  129, 181, 248, 8, 0, 88, 8, 27, 208, 128, 128, 112, 128, 136, 208, 128,
+  131, 56, 27, 95, 128, 128, 130, 88, 8, 14, 128, 128, 133, 8, 8, 11,
+  224, 128, 133, 8, 8, 141, 128, 128, 135, 8, 8, 13, 128, 128, 131, 104,
+  8, 13, 128, 128, 131, 104, 8, 12, 144, 129, 148, 88, 8, 8, 248, 8,
+  0, 88, 8, 8, 216, 8, 129, 96, 128, 128, 202, 25, 8, 71, 128, 128,
+  13, 128, 136, 21, 8, 8, 13, 144, 128, 148, 88, 8, 8, 232, 8, 9,
+  54, 128, 128, 141, 128, 128, 132, 57, 8, 45, 216, 8, 8, 112, 128, 128,
+  157, 8, 8, 6, 8, 8, 27, 224, 128, 128, 80, 128, 128, 203, 25, 25,
+  85, 128, 8, 14, 136, 8, 8, 81, 128, 129, 205, 8, 8, 6, 8, 8,
+  0, 217, 8, 9, 69, 128, 128, 15, 128, 128, 136, 66, 145, 145, 219, 8,
+  8, 166, 72, 0, 145, 233, 8, 0, 150, 24, 8, 10, 232, 8, 8, 23,
+  8, 8, 11, 177, 136, 28, 98, 128, 136, 12, 224, 128, 128, 80, 128, 128,
+  14, 144, 128, 9, 97, 128, 136, 29, 160, 128, 136, 85, 128, 128, 142, 128,
+  128, 128, 96, 128, 136, 29, 144, 128, 9, 83, 128, 136, 31, 160, 128, 9,
+  83, 128, 128, 30, 184, 128, 136, 85, 8, 0, 128, 206, 8, 8, 8, 96,
+  128, 128, 142, 128, 128, 9, 81, 128, 128, 141, 177, 145, 130, 213, 24, 8,
+  128, 233, 8, 8, 133, 57, 25, 26, 93, 144, 128, 9, 83, 145, 145, 165,
+  217, 8, 0, 149, 57, 24, 11, 107, 177, 128, 147, 243, 24, 0, 166, 186,
+  25, 25, 45, 112, 128, 128, 128, 232, 8, 0, 150, 8, 8, 8, 15, 128,
+  128, 128, 5, 8, 8, 0, 205, 8, 8, 9, 83, 145, 128, 166, 187, 25,
+  25, 63, 49, 128, 128, 149, 248, 8, 8, 0, 80, 128, 128, 12, 208, 128,
+  128, 148, 88, 8, 8, 29, 177, 145, 147, 227, 57, 8, 8, 47, 184, 128,
+  8, 166, 88, 8, 8, 12, 176, 128, 128, 46, 96, 128, 128, 136, 232, 8,
+  8, 9, 83, 145, 145, 166, 187, 24, 8, 138, 100, 24, 8, 131, 235, 128,
+  128, 131, 227, 56, 8, 0, 15, 185, 128, 128, 151, 48, 128, 128, 182, 187,
+  9, 24, 10, 116, 8, 8, 10, 76, 176, 128, 128, 47, 64, 128, 128, 128,
+  219, 8, 128, 131, 243, 41, 25, 25, 31, 176, 136, 8, 62, 51, 128, 128,
+  130, 252, 128, 128, 130, 196, 56, 8, 8, 183, 185, 8, 128, 130, 243, 41,
+  25, 25, 63, 184, 8, 8, 44, 113, 128, 128, 136, 29, 184, 8, 8, 47,
+  50, 144, 8, 9, 122, 176, 128, 8, 63, 49, 128, 128, 9, 108, 160, 128,
+  8, 9, 115, 128, 128, 128, 14, 200, 8, 9, 60, 82, 128, 128, 128, 31,
+  176, 128, 128, 131, 243, 24, 8, 129, 166, 202, 24, 128, 128, 151, 56, 8,
+  8, 130, 251, 8, 8, 8, 47, 49, 128, 128, 10, 93, 160, 128, 128, 10,
+  115, 128, 128, 128, 4, 235, 8, 8, 8, 63, 49, 128, 136, 26, 123, 161,
+  128, 145, 131, 243, 40, 8, 0, 150, 203, 25, 25, 25, 76, 82, 128, 128,
+  128, 47, 176, 128, 128, 145, 151, 72, 8, 8, 8, 47, 160, 128, 128, 128,
+  167, 56, 8, 8, 11, 123, 144, 128, 0, 154, 115, 24, 8, 8, 8, 252,
+  136, 0, 128, 147, 243, 24, 8, 128, 2, 251, 144, 128, 129, 145, 245, 8,
+  8, 8, 8, 30, 176, 128, 145, 136, 199, 40, 8, 8, 9, 63, 176, 128,
+  8, 9, 62, 66, 128, 128, 146, 182, 202, 8, 8, 26, 62, 66, 128, 128,
+  136, 25, 125, 128, 128, 128, 128, 150, 56, 8, 8, 8, 78, 176, 136, 8,
+  26, 46, 67, 128, 128, 136, 16, 124, 144, 128, 128, 8, 151, 48, 8, 128,
+  129, 133, 234, 8, 8, 8, 130, 243, 41, 24, 8, 8, 23, 216, 8, 8,
+  8, 9, 99, 128, 128, 136, 25, 123, 176, 128, 128, 12, 63, 64, 128, 128,
+  128, 10, 78, 160, 128, 128, 9, 63, 50, 145, 144, 8, 13, 46, 176, 128,
+  128, 9, 47, 51, 145, 145, 144, 25, 78, 192, 128, 128, 128, 130, 243, 41,
+  8, 24, 136, 63, 200, 8, 8, 129, 146, 243, 41, 0, 8, 128, 148, 236,
+  8, 8, 8, 8, 63, 49, 128, 128, 9, 28, 78, 160, 128, 128, 128, 137,
+  116, 8, 8, 8, 8, 10, 123, 160, 128, 136, 26, 76, 98, 128, 128, 128,
+  128, 31, 200, 8, 8, 8, 8, 47, 64, 128, 8, 8, 10, 107, 208, 128,
+  128, 128, 147, 197, 88, 8, 8, 8, 8, 31, 176, 128, 128, 128, 151, 132,
+  24, 8, 8, 9, 43, 123, 177, 128, 129, 163, 194, 214, 24, 8, 8, 8,
+  9, 77, 208, 128, 128, 128, 128, 151, 56, 8, 8, 128, 28, 47, 176, 128,
+  128, 136, 27, 74, 115, 128, 128, 128, 146, 194, 251, 8, 8, 8, 8, 26,
+  115, 24, 8, 8, 128, 60, 47, 176, 128, 128, 136, 26, 63, 21, 128, 128,
+  128, 128, 130, 251, 8, 8, 8, 1, 209, 167, 40, 8, 8, 128, 129, 225,
+  218, 8, 8, 0, 128, 178, 243, 40, 8, 8, 148, 147, 240, 201, 8, 8,
+  0, 128, 147, 244, 8, 8, 8, 8, 0, 159, 184, 128, 128, 136, 42, 60,
+  99, 128, 128, 129, 146, 164, 182, 201, 8, 8, 8, 0, 163, 244, 8, 8,
+  8, 0, 145, 164, 235, 8, 8, 8, 10, 42, 63, 50, 145, 145, 144, 0,
+  26, 124, 128, 128, 128, 136, 25, 44, 99, 128, 128, 128, 131, 193, 167, 186,
+  24, 128, 8, 145, 144, 198, 56, 8, 8, 8, 59, 74, 108, 144, 128, 128,
+  129, 147, 193, 198, 40, 8, 8, 9, 44, 27, 123, 144, 128, 128, 130, 180,
+  146, 242, 57, 25, 25, 27, 25, 18, 251, 136, 0, 128, 129, 163, 179, 243,
+  41, 8, 8, 0, 145, 144, 251, 128, 128, 8, 146, 145, 3, 243, 24, 8,
+  8, 10, 42, 43, 94, 144, 128, 128, 128, 128, 163, 241, 72, 8, 8, 8,
+  0, 162, 183, 156, 8, 8, 8, 8, 9, 26, 115, 8, 8, 8, 128, 25,
+  27, 123, 144, 128, 128, 9, 25, 25, 63, 49, 128, 128, 128, 179, 178, 182,
+  189, 8, 8, 8, 8, 130, 178, 214, 24, 8, 8, 8, 0, 163, 165, 233,
+  8, 8, 8, 8, 130, 178, 214, 24, 8, 8, 8, 0, 163, 165, 233, 8,
+  8, 8, 0, 148, 146, 242, 40, 8, 8, 129, 146, 193, 167, 170, 8, 8,
+  0, 9, 25, 26, 120, 64, 128, 128, 8, 128, 0, 47, 12, 128, 128, 136,
+  0, 137, 42, 58, 115, 128, 128, 8, 128, 9, 60, 31, 160, 128, 128, 128,
+  132, 146, 224, 150, 24, 8, 8, 8, 8, 25, 42, 123, 144, 128, 0, 128,
+  9, 25, 25, 115, 128, 128, 128, 129, 25, 26, 43, 108, 144, 128, 128, 128,
+  144, 0, 155, 115, 8, 128, 128, 0, 1, 161, 183, 155, 8, 8, 8, 16,
+  0, 0, 183, 132, 8, 8, 8, 8, 128, 43, 59, 107, 192, 128, 128, 128,
+  145, 145, 163, 228, 24, 8, 8, 8, 25, 26, 43, 121, 176, 128, 128, 0,
+  0, 0, 2, 63, 48, 128, 128, 128, 144, 0, 26, 43, 109, 128, 128, 128,
+  128, 145, 162, 163, 198, 40, 8, 8, 8, 16, 0, 0, 14, 200, 8, 8,
+  8, 16, 17, 1, 149, 133, 8, 8, 128, 137, 144, 144, 160, 144, 160,
+};
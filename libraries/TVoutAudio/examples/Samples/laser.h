@@ -0,0 +1,8 @@
+#ifndef LASER_H
+#define LASER_H
+
+#include <avr/pgmspace.h>
+
+extern const unsigned char laser[];
+
+#endif
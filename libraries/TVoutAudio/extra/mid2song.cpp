@@ -0,0 +1,483 @@
+/*
+ * mid2song - convert MIDI files to songs for TVoutAudio::play().
+ *
+ * Build on the host:
+ *	g++ -O2 -o mid2song mid2song.cpp
+ *
+ * Usage:
+ *	mid2song [options] song.mid...
+ *
+ *	-q n		rows per beat, the shortest note kept, default 4
+ *	-l n		rows per pattern, default 16
+ *	-w a,b,c	waveforms of the 3 voices, WAVE_ numbers, default 4,2,2
+ *	-c list		MIDI channels to take, 1-16 like 1,2,5, default all
+ *			but the drums on 10
+ *	-t n		transpose by n semitones
+ *	-L		loop back to the start at the end, default stop
+ *	-o dir		output directory, default the current one
+ *
+ * Reads MIDI files of format 0 and 1 and writes <name>.h and <name>.cpp per
+ * input, with one PROGMEM song named after the file, see TVoutAudio.h for
+ * the format. Note starts and ends are rounded to rows, tempo changes are
+ * followed in time while the row length stays the one of the first tempo.
+ *
+ * The notes are handed to the 3 voices from the highest pitch down, so a
+ * melody on top keeps its voice. A note finding no free voice is dropped
+ * and counted. Notes outside C0 to B7 move by octaves into the range.
+ * Velocity sets the volume. Each pattern starts from scratch, a note held
+ * over the start of a pattern is played again, which the voice does
+ * without a click as the phase carries on, so equal patterns are equal
+ * music wherever they are and are stored once.
+ */
+
+#include <ctype.h>
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+#define VOICES	3
+
+struct Options {
+	int rows_beat;
+	int rows_pattern;
+	int wave[VOICES];
+	unsigned channels;	// bit per MIDI channel
+	int transpose;
+	bool loop;
+	std::string dir;
+};
+
+struct Note {
+	long start, end;	// rows
+	int key, velocity;
+};
+
+struct Event {
+	unsigned long tick;
+	int type;		// 0 note off, 1 note on, 2 tempo
+	int channel, key, velocity;
+	long tempo;		// us per beat
+};
+
+static void die(const char * msg, const char * arg = "") {
+	fprintf(stderr, "mid2song: %s%s\n", msg, arg);
+	exit(1);
+}
+
+static uint32_t be(const uint8_t * p, int n) {
+	uint32_t v = 0;
+	for (int i = 0; i < n; i++)
+		v = v << 8 | p[i];
+	return v;
+}
+
+// MIDI variable length number
+static bool varlen(const std::vector<uint8_t> & d, size_t & i, size_t end, unsigned long & v) {
+	v = 0;
+	for (int n = 0; n < 4; n++) {
+		if (i >= end)
+			return false;
+		uint8_t c = d[i++];
+		v = v << 7 | (c & 0x7F);
+		if (!(c & 0x80))
+			return true;
+	}
+	return false;
+}
+
+/*
+ * the note and tempo events of all tracks, in tick order
+ */
+static bool load_midi(const char * path, std::vector<Event> & events, int & division, std::string & err) {
+	FILE * f = fopen(path, "rb");
+	if (!f) {
+		err = strerror(errno);
+		return false;
+	}
+	std::vector<uint8_t> d;
+	uint8_t buf[65536];
+	size_t n;
+	while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+		d.insert(d.end(), buf, buf + n);
+	fclose(f);
+
+	if (d.size() < 14 || memcmp(&d[0], "MThd", 4) || be(&d[4], 4) < 6) {
+		err = "not a MIDI file";
+		return false;
+	}
+	int format = be(&d[8], 2), tracks = be(&d[10], 2);
+	division = be(&d[12], 2);
+	if (format > 1 || division & 0x8000 || !division) {
+		err = "unsupported MIDI file, needs format 0 or 1 and beat timing";
+		return false;
+	}
+	size_t i = 8 + be(&d[4], 4);
+	for (int t = 0; t < tracks && i + 8 <= d.size(); t++) {
+		size_t len = be(&d[i + 4], 4), end = std::min(d.size(), i + 8 + len);
+		bool track = !memcmp(&d[i], "MTrk", 4);
+		size_t k = i + 8;
+		i = end;
+		if (!track)
+			continue;
+		unsigned long tick = 0, delta, size;
+		int status = 0;
+		while (k < end) {
+			if (!varlen(d, k, end, delta) || k >= end)
+				break;
+			tick += delta;
+			if (d[k] & 0x80)
+				status = d[k++];
+			if (status == 0xFF) {		// meta event
+				if (k >= end)
+					break;
+				int type = d[k++];
+				if (!varlen(d, k, end, size) || k + size > end)
+					break;
+				if (type == 0x51 && size == 3) {
+					Event e = { tick, 2, 0, 0, 0, (long)be(&d[k], 3) };
+					events.push_back(e);
+				}
+				if (type == 0x2F)
+					break;
+				k += size;
+				status = 0;
+			}
+			else if (status == 0xF0 || status == 0xF7) {	// system exclusive
+				if (!varlen(d, k, end, size) || k + size > end)
+					break;
+				k += size;
+				status = 0;
+			}
+			else if (status >= 0x80) {
+				int kind = status >> 4, bytes = kind == 0xC || kind == 0xD ? 1 : 2;
+				if (k + bytes > end)
+					break;
+				if (kind == 8 || kind == 9) {
+					int velocity = d[k + 1];
+					Event e = { tick, kind == 9 && velocity, status & 15, d[k], velocity, 0 };
+					events.push_back(e);
+				}
+				k += bytes;
+			}
+			else
+				break;			// data byte without a status
+		}
+	}
+	// offs before ons at the same tick, a repeated key stays separate notes
+	std::stable_sort(events.begin(), events.end(), [](const Event & a, const Event & b) {
+		return a.tick != b.tick ? a.tick < b.tick : a.type < b.type;
+	});
+	return true;
+}
+
+/*
+ * notes of the selected channels in rows, row_us the length of a row
+ */
+static void notes_in_rows(const std::vector<Event> & events, int division, const Options & opt,
+		std::vector<Note> & notes, double & row_us) {
+	// the first tempo sets the row, later ones only move the notes in time
+	long tempo = 500000;
+	for (size_t k = 0; k < events.size() && events[k].tick == 0; k++)
+		if (events[k].type == 2)
+			tempo = events[k].tempo;
+	row_us = (double)tempo/opt.rows_beat;
+
+	double us = 0;
+	unsigned long last = 0;
+	std::map<int, std::vector<std::pair<double, int> > > on;	// channel*128+key: start us, velocity
+	for (size_t k = 0; k < events.size(); k++) {
+		const Event & e = events[k];
+		us += (double)(e.tick - last)*tempo/division;
+		last = e.tick;
+		if (e.type == 2) {
+			tempo = e.tempo;
+			continue;
+		}
+		if (!(opt.channels & 1 << e.channel))
+			continue;
+		std::vector<std::pair<double, int> > & held = on[e.channel*128 + e.key];
+		if (e.type == 1) {
+			held.push_back(std::make_pair(us, e.velocity));
+			continue;
+		}
+		if (held.empty())
+			continue;
+		Note n;
+		n.start = lround(held.front().first/row_us);
+		n.end = std::max(n.start + 1, lround(us/row_us));
+		n.key = e.key + opt.transpose;
+		while (n.key < 12)
+			n.key += 12;
+		while (n.key > 107)
+			n.key -= 12;
+		n.velocity = held.front().second;
+		held.erase(held.begin());
+		notes.push_back(n);
+	}
+}
+
+/*
+ * notes per voice, highest first, returns the number dropped
+ */
+static int allocate(std::vector<Note> & notes, std::vector<Note> voices[VOICES]) {
+	std::sort(notes.begin(), notes.end(), [](const Note & a, const Note & b) {
+		return a.start != b.start ? a.start < b.start : a.key > b.key;
+	});
+	long free_at[VOICES] = {};
+	int dropped = 0;
+	for (size_t k = 0; k < notes.size(); k++) {
+		const Note & n = notes[k];
+		int v = 0;
+		while (v < VOICES && free_at[v] > n.start)
+			v++;
+		if (v == VOICES) {
+			// the same key played again while held ends the one before
+			for (v = 0; v < VOICES && voices[v].back().key != n.key; v++)
+				;
+			if (v == VOICES) {
+				dropped++;
+				continue;
+			}
+			voices[v].back().end = n.start;
+			if (voices[v].back().end == voices[v].back().start)
+				voices[v].pop_back();
+		}
+		voices[v].push_back(n);
+		free_at[v] = n.end;
+	}
+	return dropped;
+}
+
+/*
+ * pattern bytes of voice notes in rows [from, from + len), empty if silent
+ */
+static std::vector<uint8_t> encode_pattern(const std::vector<Note> & notes, long from, int len, int wave) {
+	std::vector<uint8_t> out;
+	std::vector<const Note *> at(len, (const Note *)0);	// note sounding at a row
+	bool any = false;
+	for (size_t k = 0; k < notes.size(); k++) {
+		const Note & n = notes[k];
+		for (long r = std::max(n.start, from); r < n.end && r < from + len; r++) {
+			at[r - from] = &n;
+			any = true;
+		}
+	}
+	if (!any)
+		return out;
+
+	out.push_back(0x60 | wave);
+	int volume = -1, wait = 0;
+	for (int r = 0; r < len; r++) {
+		const Note * n = at[r];
+		bool starts = n && (r == 0 || n->start == from + r);
+		bool ends = !n && (r == 0 || at[r - 1]);
+		if (!starts && !ends) {
+			wait++;
+			continue;
+		}
+		for (; wait > 0; wait -= std::min(wait, 128))
+			out.push_back(0x80 | (std::min(wait, 128) - 1));
+		if (starts) {
+			int v = std::min(15, n->velocity >> 3);
+			if (v != volume)
+				out.push_back(0x70 | v);
+			volume = v;
+			out.push_back(n->key - 12);
+		}
+		else
+			out.push_back(0x68);
+	}
+	for (; wait > 0; wait -= std::min(wait, 128))
+		out.push_back(0x80 | (std::min(wait, 128) - 1));
+	return out;
+}
+
+static std::string array_name(const char * path) {
+	const char * s = strrchr(path, '/');
+	std::string n = s ? s + 1 : path;
+	n = n.substr(0, n.find('.'));
+	for (size_t i = 0; i < n.size(); i++)
+		if (!isalnum((unsigned char)n[i]) && n[i] != '_')
+			n[i] = '_';
+	if (!n.empty() && isdigit((unsigned char)n[0]))
+		n = "_" + n;
+	return n.empty() ? "song" : n;
+}
+
+static bool convert(const char * path, const Options & opt) {
+	std::vector<Event> events;
+	std::vector<Note> notes, voices[VOICES];
+	int division;
+	double row_us;
+	std::string err;
+
+	if (!load_midi(path, events, division, err)) {
+		fprintf(stderr, "mid2song: %s: %s\n", path, err.c_str());
+		return false;
+	}
+	notes_in_rows(events, division, opt, notes, row_us);
+	if (notes.empty()) {
+		fprintf(stderr, "mid2song: %s: no notes\n", path);
+		return false;
+	}
+	long row_ms = lround(row_us/1000);
+	if (row_ms < 1 || row_ms > 65535) {
+		fprintf(stderr, "mid2song: %s: %.1f ms rows, change -q\n", path, row_us/1000);
+		return false;
+	}
+	int dropped = allocate(notes, voices);
+
+	long rows = 0;
+	for (int v = 0; v < VOICES; v++)
+		for (size_t k = 0; k < voices[v].size(); k++)
+			rows = std::max(rows, voices[v][k].end);
+	long orders = (rows + opt.rows_pattern - 1)/opt.rows_pattern;
+	if (orders > 255) {
+		fprintf(stderr, "mid2song: %s: more than 255 orders, raise -l\n", path);
+		return false;
+	}
+
+	// patterns, each stored once
+	std::map<std::vector<uint8_t>, int> index;
+	std::vector<std::vector<uint8_t> > patterns;
+	std::vector<uint8_t> order;
+	for (long o = 0; o < orders; o++)
+		for (int v = 0; v < VOICES; v++) {
+			std::vector<uint8_t> p = encode_pattern(voices[v], o*opt.rows_pattern, opt.rows_pattern, opt.wave[v]);
+			if (p.empty()) {
+				order.push_back(255);
+				continue;
+			}
+			std::map<std::vector<uint8_t>, int>::iterator it = index.find(p);
+			if (it == index.end()) {
+				it = index.insert(std::make_pair(p, (int)patterns.size())).first;
+				patterns.push_back(p);
+			}
+			order.push_back(it->second);
+		}
+	if (patterns.size() > 255) {
+		fprintf(stderr, "mid2song: %s: more than 255 patterns, raise -l\n", path);
+		return false;
+	}
+
+	std::vector<uint8_t> song;
+	song.push_back(row_ms & 0xFF);
+	song.push_back(row_ms >> 8);
+	song.push_back(opt.rows_pattern);
+	song.push_back(orders);
+	song.push_back(opt.loop ? 0 : 255);
+	song.push_back(patterns.size());
+	song.insert(song.end(), order.begin(), order.end());
+	size_t offset = song.size() + 2*patterns.size();
+	for (size_t k = 0; k < patterns.size(); k++) {
+		song.push_back(offset & 0xFF);
+		song.push_back(offset >> 8);
+		offset += patterns[k].size();
+	}
+	for (size_t k = 0; k < patterns.size(); k++)
+		song.insert(song.end(), patterns[k].begin(), patterns[k].end());
+	if (song.size() > 65535) {
+		fprintf(stderr, "mid2song: %s: song over 64 kB\n", path);
+		return false;
+	}
+
+	std::string name = array_name(path), base = opt.dir + "/" + name, guard = name;
+	for (size_t k = 0; k < guard.size(); k++)
+		guard[k] = toupper((unsigned char)guard[k]);
+	FILE * f = fopen((base + ".h").c_str(), "w");
+	if (!f) {
+		fprintf(stderr, "mid2song: cannot write %s.h\n", base.c_str());
+		return false;
+	}
+	fprintf(f, "#ifndef %s_H\n#define %s_H\n\n#include <avr/pgmspace.h>\n\nextern const unsigned char %s[];\n\n#endif\n",
+		guard.c_str(), guard.c_str(), name.c_str());
+	fclose(f);
+	f = fopen((base + ".cpp").c_str(), "w");
+	if (!f) {
+		fprintf(stderr, "mid2song: cannot write %s.cpp\n", base.c_str());
+		return false;
+	}
+	double seconds = rows*row_ms/1000.0;
+	fprintf(f, "// %s, %ld rows of %ld ms, %.1f s\n// Generated by mid2song\n#include \"%s.h\"\n\n"
+		"PROGMEM const unsigned char %s[] = {",
+		path, rows, row_ms, seconds, name.c_str(), name.c_str());
+	for (size_t k = 0; k < song.size(); k++)
+		fprintf(f, "%s%u,", k % 16 ? " " : "\n  ", song[k]);
+	fprintf(f, "\n};\n");
+	fclose(f);
+
+	// TV.play() takes 4 bytes a note and a rest, for one voice
+	long kept = 0;
+	for (int v = 0; v < VOICES; v++)
+		kept += voices[v].size();
+	printf("  - %s: %ld notes, %.1f s, %ld orders, %u patterns, %u bytes, %.0f bytes per minute",
+		path, kept, seconds, orders, (unsigned)patterns.size(), (unsigned)song.size(),
+		seconds > 0 ? song.size()*60/seconds : 0.0);
+	printf(", TV.play() about %ld", 8*kept);
+	if (dropped)
+		printf(", %d dropped over 3 voices", dropped);
+	printf("\n");
+	return true;
+}
+
+static void usage() {
+	fprintf(stderr,
+		"usage: mid2song [-q n] [-l n] [-w a,b,c] [-c list] [-t n] [-L] [-o dir] song.mid...\n"
+		"  converts MIDI files for TVoutAudio, see the source for details\n");
+	exit(1);
+}
+
+int main(int argc, char ** argv) {
+	Options opt = { 4, 16, { 4, 2, 2 }, 0xFFFF & ~(1 << 9), 0, false, "." };
+	int i;
+
+	for (i = 1; i < argc && argv[i][0] == '-'; i++) {
+		std::string a = argv[i];
+		bool arg = i + 1 < argc;
+		if (a == "-q" && arg)
+			opt.rows_beat = atoi(argv[++i]);
+		else if (a == "-l" && arg)
+			opt.rows_pattern = atoi(argv[++i]);
+		else if (a == "-w" && arg) {
+			if (sscanf(argv[++i], "%d,%d,%d", &opt.wave[0], &opt.wave[1], &opt.wave[2]) != 3)
+				usage();
+			for (int v = 0; v < VOICES; v++)
+				if (opt.wave[v] < 0 || opt.wave[v] > 7)
+					usage();
+		}
+		else if (a == "-c" && arg) {
+			opt.channels = 0;
+			for (char * p = argv[++i]; *p; ) {
+				long c = strtol(p, &p, 10);
+				if (c < 1 || c > 16 || (*p && *p++ != ','))
+					usage();
+				opt.channels |= 1 << (c - 1);
+			}
+		}
+		else if (a == "-t" && arg)
+			opt.transpose = atoi(argv[++i]);
+		else if (a == "-L")
+			opt.loop = true;
+		else if (a == "-o" && arg)
+			opt.dir = argv[++i];
+		else
+			usage();
+	}
+	if (i == argc || opt.rows_beat < 1 || opt.rows_pattern < 1 || opt.rows_pattern > 255)
+		usage();
+	if (mkdir(opt.dir.c_str(), 0777) && errno != EEXIST)
+		die("cannot create ", opt.dir.c_str());
+	int failed = 0;
+	for (; i < argc; i++)
+		failed |= !convert(argv[i], opt);
+	return failed;
+}
@@ -0,0 +1,405 @@
+/*
+ * wav2pcm - convert WAV files to samples for TVoutPCM.
+ *
+ * Build on the host:
+ *	g++ -O2 -o wav2pcm wav2pcm.cpp
+ *
+ * Usage:
+ *	wav2pcm [options] sound.wav...
+ *
+ *	-a		4 bit ADPCM, half the size of 8 bit PCM, default 8 bit
+ *	-p		resample to the PAL line rate, 15625 Hz, default NTSC
+ *			15736 Hz. The other standard plays 0.7% off pitch
+ *	-g dB		gain, default 0
+ *	-N		normalize to full scale, after -g
+ *	-o dir		output directory, default the current one
+ *	-w		also write <name>_tv.wav, the sound as TVoutPCM plays it
+ *
+ * Reads PCM WAV of 8 to 32 bits and float WAV, at any rate and channel
+ * count, mixed down to mono. Writes <name>.h and <name>.cpp per input, with
+ * one PROGMEM array named after the file:
+ *	{format, samples lo, samples hi, data...}
+ * format 1 is unsigned 8 bit PCM, 2 is ADPCM with two samples per byte,
+ * high nibble first. A sound holds at most 65534 samples, 4.1 s, longer
+ * input is cut. Both ends fade over 2 ms so a sample starts and stops at
+ * mid level without a click.
+ *
+ * ADPCM codes are sign and magnitude m, the value moves by (2m+1)*step/2
+ * and the step index into pcm_steps[] adapts by pcm_adapt[m], see
+ * TVoutPCM.cpp; the tables here have to match. The decoder state is only
+ * the value and the step index, so the encoder runs a beam search over
+ * them, keeping the 256 best code sequences, which gains about 10 dB over
+ * picking the closest code sample by sample. The signal to noise ratio
+ * against the 8 bit version is reported.
+ */
+
+#include <ctype.h>
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#define PCM_8BIT	1
+#define PCM_ADPCM	2
+
+static const uint8_t pcm_steps[16] = { 1, 2, 3, 4, 5, 6, 8, 10, 13, 16, 20, 25, 32, 40, 50, 64 };
+static const int8_t pcm_adapt[8] = { -1, -1, -1, -1, 2, 4, 6, 8 };
+
+struct Options {
+	bool adpcm;
+	double rate;
+	double gain;
+	bool normalize;
+	std::string dir;
+	bool preview;
+};
+
+static uint32_t le(const uint8_t * p, int n) {
+	uint32_t v = 0;
+	for (int i = n - 1; i >= 0; i--)
+		v = v << 8 | p[i];
+	return v;
+}
+
+/*
+ * mono samples in -1..1 and the sample rate
+ */
+static bool load_wav(const char * path, std::vector<double> & out, double & rate, std::string & err) {
+	FILE * f = fopen(path, "rb");
+	if (!f) {
+		err = strerror(errno);
+		return false;
+	}
+	std::vector<uint8_t> d;
+	uint8_t buf[65536];
+	size_t n;
+	while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+		d.insert(d.end(), buf, buf + n);
+	fclose(f);
+
+	if (d.size() < 12 || memcmp(&d[0], "RIFF", 4) || memcmp(&d[8], "WAVE", 4)) {
+		err = "not a WAV file";
+		return false;
+	}
+	int format = 0, channels = 0, bits = 0;
+	const uint8_t * data = 0;
+	size_t size = 0;
+	for (size_t i = 12; i + 8 <= d.size(); ) {
+		size_t len = le(&d[i + 4], 4);
+		if (len > d.size() - i - 8)
+			len = d.size() - i - 8;
+		if (!memcmp(&d[i], "fmt ", 4) && len >= 16) {
+			format = le(&d[i + 8], 2);
+			channels = le(&d[i + 10], 2);
+			rate = le(&d[i + 12], 4);
+			bits = le(&d[i + 22], 2);
+			if (format == 0xFFFE && len >= 26)	// WAVE_FORMAT_EXTENSIBLE
+				format = le(&d[i + 32], 2);
+		}
+		else if (!memcmp(&d[i], "data", 4)) {
+			data = &d[i + 8];
+			size = len;
+		}
+		i += 8 + len + (len & 1);
+	}
+	if (!data || !channels || !rate || !(
+			(format == 1 && bits >= 8 && bits <= 32 && bits % 8 == 0) || (format == 3 && (bits == 32 || bits == 64)))) {
+		err = "unsupported WAV format, needs PCM or float";
+		return false;
+	}
+
+	int bytes = bits/8, frame = bytes*channels;
+	out.resize(size/frame);
+	for (size_t k = 0; k < out.size(); k++) {
+		double sum = 0;
+		for (int c = 0; c < channels; c++) {
+			const uint8_t * p = data + k*frame + c*bytes;
+			uint32_t u = le(p, bytes);
+			double v;
+			if (format == 3 && bits == 32) {
+				float x;
+				memcpy(&x, &u, 4);
+				v = x;
+			}
+			else if (format == 3) {
+				uint64_t w = (uint64_t)le(p + 4, 4) << 32 | u;
+				double x;
+				memcpy(&x, &w, 8);
+				v = x;
+			}
+			else if (bits == 8)
+				v = ((int)u - 128)/128.0;
+			else
+				v = (int32_t)(u << (32 - bits))/2147483648.0;
+			sum += v;
+		}
+		out[k] = sum/channels;
+	}
+	return true;
+}
+
+/*
+ * windowed sinc resampling, low pass at the lower Nyquist frequency
+ */
+static void resample(const std::vector<double> & in, double from, double to, std::vector<double> & out) {
+	const int taps = 16;
+	double ratio = from/to, cut = std::min(1.0, to/from);
+	size_t n = (size_t)(in.size()/ratio);
+
+	out.resize(n);
+	for (size_t k = 0; k < n; k++) {
+		double pos = k*ratio, sum = 0, wsum = 0;
+		long c = (long)floor(pos);
+		long span = (long)ceil(taps/cut);
+		for (long i = c - span + 1; i <= c + span; i++) {
+			double x = (i - pos)*cut;
+			if (fabs(x) >= taps)
+				continue;
+			double s = x == 0 ? 1 : sin(M_PI*x)/(M_PI*x);
+			double w = 0.5 + 0.5*cos(M_PI*x/taps);
+			if (i >= 0 && i < (long)in.size())
+				sum += in[i]*s*w;
+			wsum += s*w;
+		}
+		out[k] = wsum ? sum/wsum : 0;
+	}
+}
+
+static void adpcm_encode(const std::vector<uint8_t> & pcm, std::vector<uint8_t> & out, std::vector<uint8_t> & decoded) {
+	struct Node {
+		uint64_t cost;
+		uint8_t value, index, code;
+		int parent;
+	};
+	// what the traceback needs of a node, kept for every sample
+	struct Link {
+		uint8_t code, parent;
+	};
+	const size_t beam = 256;
+	std::vector<std::vector<Link> > links(pcm.size() + 1);
+	std::vector<int> best(256*16, -1);
+	std::vector<Node> prev, next;
+
+	prev.push_back(Node { 0, 128, 0, 0, -1 });
+	for (size_t k = 0; k < pcm.size(); k++) {
+		next.clear();
+		// the cheapest way into every (value, index) state
+		for (size_t p = 0; p < prev.size(); p++)
+			for (int code = 0; code < 16; code++) {
+				const Node & n = prev[p];
+				int m = code & 7, d = ((2*m + 1)*pcm_steps[n.index]) >> 1;
+				int v = code & 8 ? std::max(n.value - d, 0) : std::min(n.value + d, 255);
+				int i = std::max(0, std::min(15, n.index + pcm_adapt[m]));
+				uint64_t cost = n.cost + (v - pcm[k])*(v - pcm[k]);
+				int & b = best[v << 4 | i];
+				if (b < 0) {
+					b = next.size();
+					next.push_back(Node { cost, (uint8_t)v, (uint8_t)i, (uint8_t)code, (int)p });
+				}
+				else if (cost < next[b].cost)
+					next[b] = Node { cost, (uint8_t)v, (uint8_t)i, (uint8_t)code, (int)p };
+			}
+		for (size_t n = 0; n < next.size(); n++)
+			best[next[n].value << 4 | next[n].index] = -1;
+		if (next.size() > beam) {
+			std::nth_element(next.begin(), next.begin() + beam, next.end(),
+				[](const Node & a, const Node & b) { return a.cost < b.cost; });
+			next.resize(beam);
+		}
+		links[k + 1].resize(next.size());
+		for (size_t n = 0; n < next.size(); n++)
+			links[k + 1][n] = Link { next[n].code, (uint8_t)next[n].parent };
+		prev.swap(next);
+	}
+
+	// back from the cheapest end
+	std::vector<uint8_t> codes(pcm.size());
+	int p = std::min_element(prev.begin(), prev.end(),
+		[](const Node & a, const Node & b) { return a.cost < b.cost; }) - prev.begin();
+	for (size_t k = pcm.size(); k > 0; k--) {
+		codes[k - 1] = links[k][p].code;
+		p = links[k][p].parent;
+	}
+
+	// decode again for the values played
+	int v = 128, i = 0;
+	decoded.resize(pcm.size());
+	for (size_t k = 0; k < codes.size(); k++) {
+		int m = codes[k] & 7, d = ((2*m + 1)*pcm_steps[i]) >> 1;
+		v = codes[k] & 8 ? std::max(v - d, 0) : std::min(v + d, 255);
+		i = std::max(0, std::min(15, i + pcm_adapt[m]));
+		decoded[k] = v;
+	}
+	out.clear();
+	for (size_t k = 0; k < codes.size(); k += 2)
+		out.push_back(codes[k] << 4 | codes[k + 1]);
+}
+
+static std::string array_name(const char * path) {
+	const char * s = strrchr(path, '/');
+	std::string n = s ? s + 1 : path;
+	n = n.substr(0, n.find('.'));
+	for (size_t i = 0; i < n.size(); i++)
+		if (!isalnum((unsigned char)n[i]) && n[i] != '_')
+			n[i] = '_';
+	if (!n.empty() && isdigit((unsigned char)n[0]))
+		n = "_" + n;
+	return n.empty() ? "sample" : n;
+}
+
+static bool write_wav(const std::string & path, const std::vector<uint8_t> & pcm, double rate) {
+	FILE * f = fopen(path.c_str(), "wb");
+	if (!f)
+		return false;
+	uint32_t n = pcm.size(), r = (uint32_t)(rate + 0.5);
+	uint8_t h[44] = { 'R', 'I', 'F', 'F', 0, 0, 0, 0, 'W', 'A', 'V', 'E', 'f', 'm', 't', ' ',
+		16, 0, 0, 0, 1, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 8, 0, 'd', 'a', 't', 'a' };
+	for (int i = 0; i < 4; i++) {
+		h[4 + i] = (36 + n) >> 8*i;
+		h[24 + i] = r >> 8*i;
+		h[28 + i] = r >> 8*i;
+		h[40 + i] = n >> 8*i;
+	}
+	fwrite(h, 1, sizeof(h), f);
+	fwrite(pcm.data(), 1, n, f);
+	fclose(f);
+	return true;
+}
+
+static bool convert(const char * path, const Options & opt) {
+	std::vector<double> in, s;
+	double rate = 0;
+	std::string err;
+
+	if (!load_wav(path, in, rate, err)) {
+		fprintf(stderr, "wav2pcm: %s: %s\n", path, err.c_str());
+		return false;
+	}
+	resample(in, rate, opt.rate, s);
+	if (s.size() > 65534) {
+		fprintf(stderr, "wav2pcm: %s: cut to 65534 samples, %.2f s\n", path, 65534/opt.rate);
+		s.resize(65534);
+	}
+	if (opt.adpcm && s.size() & 1)
+		s.push_back(0);
+
+	double gain = pow(10, opt.gain/20), peak = 0;
+	for (size_t k = 0; k < s.size(); k++)
+		peak = std::max(peak, fabs(s[k]*gain));
+	if (opt.normalize && peak > 0)
+		gain *= 1/peak;
+	size_t fade = (size_t)(opt.rate*0.002);
+	std::vector<uint8_t> pcm(s.size());
+	int clipped = 0;
+	for (size_t k = 0; k < s.size(); k++) {
+		double v = s[k]*gain;
+		if (k < fade)
+			v *= (double)k/fade;
+		if (s.size() - 1 - k < fade)
+			v *= (double)(s.size() - 1 - k)/fade;
+		long q = lround(128 + v*127);
+		if (q < 0 || q > 255)
+			clipped++;
+		pcm[k] = std::max(0L, std::min(255L, q));
+	}
+
+	std::vector<uint8_t> data, decoded;
+	if (opt.adpcm)
+		adpcm_encode(pcm, data, decoded);
+	else
+		data = decoded = pcm;
+
+	std::string name = array_name(path), base = opt.dir + "/" + name, guard = name;
+	for (size_t k = 0; k < guard.size(); k++)
+		guard[k] = toupper((unsigned char)guard[k]);
+	FILE * f = fopen((base + ".h").c_str(), "w");
+	if (!f) {
+		fprintf(stderr, "wav2pcm: cannot write %s.h\n", base.c_str());
+		return false;
+	}
+	fprintf(f, "#ifndef %s_H\n#define %s_H\n\n#include <avr/pgmspace.h>\n\nextern const unsigned char %s[];\n\n#endif\n",
+		guard.c_str(), guard.c_str(), name.c_str());
+	fclose(f);
+	f = fopen((base + ".cpp").c_str(), "w");
+	if (!f) {
+		fprintf(stderr, "wav2pcm: cannot write %s.cpp\n", base.c_str());
+		return false;
+	}
+	fprintf(f, "// %s, %s at %.0f Hz, %.2f s\n// Generated by wav2pcm\n#include \"%s.h\"\n\n"
+		"PROGMEM const unsigned char %s[] = {\n  %d, %u, %u,",
+		path, opt.adpcm ? "4 bit ADPCM" : "8 bit PCM", opt.rate, s.size()/opt.rate, name.c_str(),
+		name.c_str(), opt.adpcm ? PCM_ADPCM : PCM_8BIT, (unsigned)(s.size() & 0xFF), (unsigned)(s.size() >> 8));
+	for (size_t k = 0; k < data.size(); k++)
+		fprintf(f, "%s%u,", k % 16 ? " " : "\n  ", data[k]);
+	fprintf(f, "\n};\n");
+	fclose(f);
+
+	printf("  - %s: %u samples, %.2f s, %u bytes", path, (unsigned)s.size(), s.size()/opt.rate,
+		(unsigned)data.size() + 3);
+	if (clipped)
+		printf(", %d clipped", clipped);
+	if (opt.adpcm) {
+		double sig = 0, noise = 0;
+		for (size_t k = 0; k < pcm.size(); k++) {
+			sig += (pcm[k] - 128.0)*(pcm[k] - 128.0);
+			noise += (decoded[k] - (double)pcm[k])*(decoded[k] - (double)pcm[k]);
+		}
+		if (noise > 0 && sig > 0)
+			printf(", SNR %.1f dB", 10*log10(sig/noise));
+	}
+	printf("\n");
+	if (opt.preview && !write_wav(base + "_tv.wav", decoded, opt.rate)) {
+		fprintf(stderr, "wav2pcm: cannot write %s_tv.wav\n", base.c_str());
+		return false;
+	}
+	return true;
+}
+
+static void usage() {
+	fprintf(stderr,
+		"usage: wav2pcm [-a] [-p] [-g dB] [-N] [-o dir] [-w] sound.wav...\n"
+		"  converts WAV files for TVoutPCM, see the source for details\n");
+	exit(1);
+}
+
+int main(int argc, char ** argv) {
+	// line rates, 1/63.55 us and 1/64 us
+	Options opt = { false, 1e6/63.55, 0, false, ".", false };
+	int i;
+
+	for (i = 1; i < argc && argv[i][0] == '-'; i++) {
+		std::string a = argv[i];
+		bool arg = i + 1 < argc;
+		if (a == "-a")
+			opt.adpcm = true;
+		else if (a == "-p")
+			opt.rate = 1e6/64;
+		else if (a == "-g" && arg)
+			opt.gain = atof(argv[++i]);
+		else if (a == "-N")
+			opt.normalize = true;
+		else if (a == "-o" && arg)
+			opt.dir = argv[++i];
+		else if (a == "-w")
+			opt.preview = true;
+		else
+			usage();
+	}
+	if (i == argc)
+		usage();
+	if (mkdir(opt.dir.c_str(), 0777) && errno != EEXIST) {
+		fprintf(stderr, "wav2pcm: cannot create %s\n", opt.dir.c_str());
+		return 1;
+	}
+	int failed = 0;
+	for (; i < argc; i++)
+		failed |= !convert(argv[i], opt);
+	return failed;
+}
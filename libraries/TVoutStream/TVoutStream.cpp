@@ -0,0 +1,109 @@
+#include "TVoutStream.h"
+#include <avr/interrupt.h>
+#include <TVout.h>
+
+// receiver states
+#define WAIT_PACKET	0
+#define OFFSET_LO	1
+#define OFFSET_HI	2
+#define LENGTH		3
+#define DATA		4
+
+static uint8_t state;
+static uint16_t offset;
+static uint8_t left;
+static uint8_t * dst;
+static volatile uint16_t frame_count, error_count;
+
+// hbi hook: apply every byte the usart holds
+void stream_receive() {
+	uint8_t c;
+
+#if defined ( UDR0 )
+	while (UCSR0A & _BV(RXC0)) {
+		c = UDR0;
+#else
+	while (UCSRA & _BV(RXC)) {
+		c = UDR;
+#endif
+		switch (state) {
+			case WAIT_PACKET:
+				if (c == STREAM_SPAN)
+					state = OFFSET_LO;
+				else if (c == STREAM_FRAME)
+					frame_count++;
+				break;
+			case OFFSET_LO:
+				offset = c;
+				state = OFFSET_HI;
+				break;
+			case OFFSET_HI:
+				offset |= c << 8;
+				state = LENGTH;
+				break;
+			case LENGTH:
+				if (!c || offset + c > display.hres*display.vres) {
+					error_count++;
+					state = WAIT_PACKET;
+					break;
+				}
+				left = c;
+				dst = display.screen + offset;
+				state = DATA;
+				break;
+			case DATA:
+				*dst++ = c;
+				if (!--left)
+					state = WAIT_PACKET;
+				break;
+		}
+	}
+}
+
+pt2Funct TVoutStream::begin(unsigned long baud) {
+	uint16_t ubrr = (F_CPU / 4 / baud - 1) / 2;
+
+	state = WAIT_PACKET;
+	frame_count = 0;
+	error_count = 0;
+#if defined ( UDR0 )
+	UCSR0A = _BV(U2X0);
+	UBRR0H = ubrr >> 8;
+	UBRR0L = ubrr;
+	UCSR0B = _BV(RXEN0);
+	UCSR0C = _BV(UCSZ01) | _BV(UCSZ00);
+#else
+	UCSRA = _BV(U2X);
+	UBRRH = ubrr >> 8;
+	UBRRL = ubrr;
+	UCSRB = _BV(RXEN);
+	UCSRC = _BV(URSEL) | _BV(UCSZ1) | _BV(UCSZ0);
+#endif
+	return &stream_receive;
+}
+
+void TVoutStream::end() {
+#if defined ( UDR0 )
+	UCSR0B &= ~_BV(RXEN0);
+#else
+	UCSRB &= ~_BV(RXEN);
+#endif
+}
+
+uint16_t TVoutStream::frames() {
+	uint16_t n;
+	uint8_t sreg = SREG;
+	cli();
+	n = frame_count;
+	SREG = sreg;
+	return n;
+}
+
+uint16_t TVoutStream::errors() {
+	uint16_t n;
+	uint8_t sreg = SREG;
+	cli();
+	n = error_count;
+	SREG = sreg;
+	return n;
+}
@@ -0,0 +1,60 @@
+/*
+ TVoutStream - framebuffer streaming over the serial port for TVout.
+
+ The usart is polled once per scan line from the TVout hbi hook, the same way
+ pollserial and PS2uartKeyboard do it, so reception never disturbs the video
+ timing. Received bytes are applied to the TVout frame buffer as they come in,
+ there is no buffer in RAM.
+
+ The host sends packets, see extra/fbstream.cpp for a sender:
+	0xA5 offset_lo offset_hi length data...
+		length (1-255) bytes copied to screen[offset], offset is the byte
+		index into the frame buffer, hres/8 bytes per line.
+	0x5A
+		end of frame, counted by frames().
+ Other bytes between packets are skipped, so the receiver finds its way back
+ after lost bytes. A span running past the end of the frame buffer is dropped
+ and counted by errors().
+
+ One byte takes 10 bits on the line and the usart holds 3 bytes between two
+ polls, so the link must stay below about 300000 baud. 250000 baud divides
+ 16MHz exactly and streams about 25 kilobytes per second.
+
+ Usage:
+	TVout TV;
+	TVoutStream stream;
+
+	void setup() {
+		TV.begin(NTSC, 128, 96);
+		TV.set_hbi_hook(stream.begin(250000));
+	}
+*/
+
+#ifndef TVOUTSTREAM_H
+#define TVOUTSTREAM_H
+
+#include <stdint.h>
+#include <avr/io.h>
+
+#define STREAM_SPAN		0xA5
+#define STREAM_FRAME	0x5A
+
+//define a void function() return type.
+typedef void (*pt2Funct)();
+
+class TVoutStream {
+public:
+	// Sets up the usart for reception, TV.begin() has to be called first.
+	// Returns the hook to pass to TV.set_hbi_hook().
+	pt2Funct begin(unsigned long baud);
+	// Stops reception.
+	void end();
+	// Number of end of frame markers received.
+	uint16_t frames();
+	// Number of spans dropped for being out of range.
+	uint16_t errors();
+};
+
+void stream_receive();
+
+#endif
@@ -0,0 +1,18 @@
+// Shows frames streamed from a PC, start the sender with
+//   fbstream -s 128x96 /dev/ttyUSB0 frame*.pbm
+// or pipe PBM frames into it, see extra/fbstream.cpp.
+#include <TVout.h>
+#include <TVoutStream.h>
+
+TVout TV;
+TVoutStream stream;
+
+void setup() {
+  TV.begin(NTSC, 128, 96);
+  TV.set_hbi_hook(stream.begin(250000));
+}
+
+void loop() {
+  // everything happens in the hbi hook, the sketch is free for other work
+  TV.delay_frame(1);
+}
@@ -0,0 +1,341 @@
+/*
+ * fbstream - stream frames to a TVoutStream receiver over a serial port.
+ *
+ * Build on the host (Linux):
+ *	g++ -O2 -o fbstream fbstream.cpp
+ *
+ * Usage:
+ *	fbstream [options] device frame.pbm...
+ *	fbstream [options] device -		frames from stdin
+ *	fbstream -e [options] device out.pbm	emulated receiver
+ *
+ *	-b baud		line speed, default 250000 as the receiver expects
+ *	-s WxH		size of the TVout frame buffer, default 128x96
+ *	-r fps		send at most this many frames per second, default as
+ *			fast as the line takes them
+ *	-k n		send every n-th frame in full, to recover from bytes lost
+ *			on the line, default only the first
+ *	-i		do not invert, PBM black pixels become white pixels
+ *	-v		print the size of every frame
+ *	-e		emulate the receiver: apply the packets read from device
+ *			to a frame buffer and write it to out.pbm after every
+ *			frame, like the sketch would show it
+ *	-n n		with -e, stop after n frames
+ *
+ * Frames are binary PBM (P4) of exactly the frame buffer size, stdin takes
+ * them back to back so a program can render into the pipe. Every frame is
+ * compared with the one sent before and only the bytes that changed are sent
+ * as spans, see TVoutStream.h for the packet format. Runs of up to 4
+ * unchanged bytes are sent along as they cost less than a new span header.
+ *
+ * A loopback test without hardware, with socat:
+ *	socat pty,raw,echo=0,link=/tmp/tx pty,raw,echo=0,link=/tmp/rx &
+ *	fbstream -e -n 10 /tmp/rx out.pbm &
+ *	fbstream /tmp/tx frame*.pbm
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <asm/ioctls.h>
+#include <asm/termbits.h>
+
+#include <string>
+#include <vector>
+
+// <sys/ioctl.h> clashes with <asm/termbits.h>, which has termios2
+extern "C" int ioctl(int fd, unsigned long request, ...);
+
+#define STREAM_SPAN	0xA5
+#define STREAM_FRAME	0x5A
+
+struct Options {
+	int width, height;
+	unsigned baud;
+	double fps;
+	int keyframe;
+	bool invert;
+	bool verbose;
+	long frames;
+};
+
+static void die(const char * msg, const char * arg = "") {
+	fprintf(stderr, "fbstream: %s%s%s%s\n", msg, arg, errno ? ": " : "", errno ? strerror(errno) : "");
+	exit(1);
+}
+
+/*
+ * raw 8N1 at any rate, termios2 takes the baud rate as a number
+ */
+static int open_port(const char * path, unsigned baud, bool reading) {
+	int fd = open(path, (reading ? O_RDONLY : O_WRONLY) | O_NOCTTY);
+	if (fd < 0)
+		die("cannot open ", path);
+
+	struct termios2 tio;
+	if (ioctl(fd, TCGETS2, &tio) == 0) {
+		tio.c_iflag = 0;
+		tio.c_oflag = 0;
+		tio.c_lflag = 0;
+		tio.c_cflag = CS8 | CREAD | CLOCAL | BOTHER;
+		tio.c_ispeed = baud;
+		tio.c_ospeed = baud;
+		tio.c_cc[VMIN] = 1;
+		tio.c_cc[VTIME] = 0;
+		if (ioctl(fd, TCSETS2, &tio))
+			die("cannot set up ", path);
+	}
+	errno = 0;
+	return fd;
+}
+
+static void write_all(int fd, const uint8_t * p, size_t n) {
+	while (n) {
+		ssize_t k = write(fd, p, n);
+		if (k < 0) {
+			if (errno == EINTR)
+				continue;
+			die("write failed");
+		}
+		p += k;
+		n -= k;
+	}
+}
+
+static int pbm_field(FILE * f) {
+	int c, v = 0;
+	while ((c = getc(f)) != EOF) {
+		if (c == '#')
+			while ((c = getc(f)) != EOF && c != '\n')
+				;
+		else if (c >= '0' && c <= '9')
+			break;
+	}
+	if (c == EOF)
+		return -1;
+	for (; c >= '0' && c <= '9'; c = getc(f))
+		v = v*10 + c - '0';
+	return v;
+}
+
+/*
+ * next P4 frame of f in screen layout, returns false at the end of f
+ */
+static bool read_frame(FILE * f, const char * name, const Options & opt, std::vector<uint8_t> & frame) {
+	int c = getc(f);
+	while (c == '\n' || c == ' ' || c == '\r' || c == '\t')
+		c = getc(f);
+	if (c == EOF)
+		return false;
+	if (c != 'P' || getc(f) != '4')
+		die("not a binary PBM: ", name);
+	int w = pbm_field(f), h = pbm_field(f);
+	if (w != opt.width || h != opt.height)
+		die("frame size differs from -s: ", name);
+	frame.resize((size_t)(w/8)*h);
+	if (fread(frame.data(), 1, frame.size(), f) != frame.size())
+		die("truncated frame: ", name);
+	// PBM has black as set bits, TVout white
+	if (!opt.invert)
+		for (size_t i = 0; i < frame.size(); i++)
+			frame[i] = ~frame[i];
+	return true;
+}
+
+/*
+ * spans of the bytes that differ between prev and cur, everything with full
+ */
+static void encode_frame(const std::vector<uint8_t> & prev, const std::vector<uint8_t> & cur, bool full,
+		std::vector<uint8_t> & out) {
+	size_t n = cur.size();
+
+	out.clear();
+	for (size_t i = 0; i < n; ) {
+		if (!full && prev[i] == cur[i]) {
+			i++;
+			continue;
+		}
+		size_t last = i, end = i + 1;
+		while (end < n && end - i < 255 && (full || end - last <= 4)) {
+			if (full || prev[end] != cur[end])
+				last = end;
+			end++;
+		}
+		out.push_back(STREAM_SPAN);
+		out.push_back(i & 0xFF);
+		out.push_back(i >> 8);
+		out.push_back(last + 1 - i);
+		out.insert(out.end(), cur.begin() + i, cur.begin() + last + 1);
+		i = last + 1;
+	}
+	out.push_back(STREAM_FRAME);
+}
+
+static double now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec*1e-9;
+}
+
+static int stream_frames(const char * device, char ** inputs, int count, const Options & opt) {
+	int fd = open_port(device, opt.baud, false);
+	std::vector<uint8_t> prev, cur, packet;
+	unsigned long total = 0, full_total = 0;
+	long frames = 0;
+	double start = now();
+
+	for (int k = 0; k < count; k++) {
+		bool from_stdin = !strcmp(inputs[k], "-");
+		FILE * f = from_stdin ? stdin : fopen(inputs[k], "rb");
+		if (!f)
+			die("cannot open ", inputs[k]);
+		while (read_frame(f, inputs[k], opt, cur)) {
+			bool full = prev.empty() || (opt.keyframe && frames % opt.keyframe == 0);
+			encode_frame(prev, cur, full, packet);
+			if (opt.fps > 0) {
+				double due = start + frames/opt.fps, t = now();
+				if (due > t)
+					usleep((useconds_t)((due - t)*1e6));
+			}
+			write_all(fd, packet.data(), packet.size());
+			if (opt.verbose)
+				fprintf(stderr, "frame %ld: %u bytes%s\n", frames, (unsigned)packet.size(), full ? " (full)" : "");
+			total += packet.size();
+			full_total += cur.size() + 4*((cur.size() + 254)/255) + 1;
+			prev = cur;
+			frames++;
+		}
+		if (!from_stdin)
+			fclose(f);
+	}
+	close(fd);
+
+	if (frames)
+		printf("%ld frame(s), %lu bytes, %.1f bytes per frame, %.0f%% of full frames, "
+			"%.1f ms per frame at %u baud\n",
+			frames, total, (double)total/frames, 100.0*total/full_total,
+			1000.0*total*10/opt.baud/frames, opt.baud);
+	return 0;
+}
+
+static void write_pbm(const char * path, const std::vector<uint8_t> & screen, const Options & opt) {
+	std::string tmp = std::string(path) + ".tmp";
+	FILE * f = fopen(tmp.c_str(), "wb");
+	if (!f)
+		die("cannot write ", tmp.c_str());
+	fprintf(f, "P4\n%d %d\n", opt.width, opt.height);
+	for (size_t i = 0; i < screen.size(); i++)
+		putc(opt.invert ? screen[i] : ~screen[i] & 0xFF, f);
+	fclose(f);
+	if (rename(tmp.c_str(), path))
+		die("cannot write ", path);
+}
+
+/*
+ * the state machine of stream_receive() in TVoutStream.cpp
+ */
+static int emulate(const char * device, const char * out, const Options & opt) {
+	int fd = open_port(device, opt.baud, true);
+	std::vector<uint8_t> screen((size_t)(opt.width/8)*opt.height, 0);
+	enum { WAIT_PACKET, OFFSET_LO, OFFSET_HI, LENGTH, DATA } state = WAIT_PACKET;
+	unsigned offset = 0, left = 0, errors = 0;
+	long frames = 0;
+	uint8_t buf[4096];
+	ssize_t n;
+
+	while (frames != opt.frames && (n = read(fd, buf, sizeof(buf))) != 0) {
+		if (n < 0) {
+			if (errno == EINTR)
+				continue;
+			die("read failed");
+		}
+		for (ssize_t i = 0; i < n && frames != opt.frames; i++) {
+			uint8_t c = buf[i];
+			switch (state) {
+				case WAIT_PACKET:
+					if (c == STREAM_SPAN)
+						state = OFFSET_LO;
+					else if (c == STREAM_FRAME) {
+						write_pbm(out, screen, opt);
+						frames++;
+					}
+					break;
+				case OFFSET_LO:
+					offset = c;
+					state = OFFSET_HI;
+					break;
+				case OFFSET_HI:
+					offset |= c << 8;
+					state = LENGTH;
+					break;
+				case LENGTH:
+					if (!c || offset + c > screen.size()) {
+						errors++;
+						state = WAIT_PACKET;
+						break;
+					}
+					left = c;
+					state = DATA;
+					break;
+				case DATA:
+					screen[offset++] = c;
+					if (!--left)
+						state = WAIT_PACKET;
+					break;
+			}
+		}
+	}
+	close(fd);
+	printf("%ld frame(s) received, %u error(s)\n", frames, errors);
+	return errors ? 1 : 0;
+}
+
+static void usage() {
+	fprintf(stderr,
+		"usage: fbstream [-b baud] [-s WxH] [-r fps] [-k n] [-i] [-v] device frame.pbm...|-\n"
+		"       fbstream -e [-b baud] [-s WxH] [-i] [-n frames] device out.pbm\n"
+		"  streams frames to TVoutStream, see the source for details\n");
+	exit(1);
+}
+
+int main(int argc, char ** argv) {
+	Options opt = { 128, 96, 250000, 0, 0, false, false, -1 };
+	bool receive = false;
+	int i;
+
+	for (i = 1; i < argc && argv[i][0] == '-' && argv[i][1]; i++) {
+		std::string a = argv[i];
+		bool arg = i + 1 < argc;
+		if (a == "-b" && arg)
+			opt.baud = strtoul(argv[++i], 0, 10);
+		else if (a == "-s" && arg) {
+			if (sscanf(argv[++i], "%dx%d", &opt.width, &opt.height) != 2 ||
+				opt.width < 8 || opt.width % 8 || opt.height < 1 || opt.width/8*opt.height > 65535)
+				usage();
+		}
+		else if (a == "-r" && arg)
+			opt.fps = atof(argv[++i]);
+		else if (a == "-k" && arg)
+			opt.keyframe = atoi(argv[++i]);
+		else if (a == "-n" && arg)
+			opt.frames = atol(argv[++i]);
+		else if (a == "-i")
+			opt.invert = true;
+		else if (a == "-v")
+			opt.verbose = true;
+		else if (a == "-e")
+			receive = true;
+		else
+			usage();
+	}
+	if (argc - i < 2 || !opt.baud || (receive && argc - i != 2))
+		usage();
+	if (receive)
+		return emulate(argv[i], argv[i + 1], opt);
+	return stream_frames(argv[i], argv + i + 1, argc - i - 1, opt);
+}
@@ -0,0 +1,524 @@
+/*
+ * fontconv - convert BDF and PSF (v1/v2) bitmap fonts to TVout font tables.
+ *
+ * Build on the host (Linux):
+ *	g++ -O2 -o fontconv fontconv.cpp
+ *
+ * Usage:
+ *	fontconv [options] font.bdf|font.psf
+ *
+ *	-n name		name of the table, default the input file name
+ *	-o base		write base.cpp and base.h, default the table name
+ *	-r first-last	characters to convert, default 32-126
+ *	-s "text"	subset: only the characters in the UTF-8 text
+ *	-S file		subset: the characters used in the file, for sketches and
+ *			C/C++ sources only the string and character literals.
+ *			can be given more than once
+ *	-p		bit pack the rows, the width gets bit 7 set
+ *
+ * With a range the character codes of the table are the code points of the
+ * font. A subset is stored densely from character 63, '?' first as it is the
+ * replacement for unmapped code points, and a code page map <name>_map is
+ * written to go with it:
+ *	TV.select_font(name, name_map);
+ *
+ * Glyphs are placed in the font bounding box, widths up to 16 pixels are
+ * supported. The output matches the fonts of the TVoutfonts library:
+ *	{width, height, first char, rows...}
+ * rows padded to whole bytes, or packed back to back with -p.
+ */
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+struct Font {
+	int width, height;
+	// glyph rows by code point, bit 15 is the leftmost pixel
+	std::map<uint32_t, std::vector<uint16_t> > glyphs;
+};
+
+static void die(const char * msg, const char * arg = "") {
+	fprintf(stderr, "fontconv: %s%s\n", msg, arg);
+	exit(1);
+}
+
+static bool read_file(const char * path, std::string & out) {
+	FILE * f = fopen(path, "rb");
+	if (!f)
+		return false;
+	char buf[4096];
+	size_t n;
+	out.clear();
+	while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+		out.append(buf, n);
+	fclose(f);
+	return true;
+}
+
+/*
+ * decode one UTF-8 sequence at s[i], advances i.
+ * malformed bytes are returned as they are.
+ */
+static uint32_t utf8_next(const std::string & s, size_t & i) {
+	uint8_t c = s[i++];
+	int more;
+	uint32_t cp;
+
+	if (c < 0xC0)
+		return c;
+	more = c >= 0xF0 ? 3 : c >= 0xE0 ? 2 : 1;
+	cp = c & (0x3F >> more);
+	while (more-- && i < s.size() && (s[i] & 0xC0) == 0x80)
+		cp = (cp << 6) | (s[i++] & 0x3F);
+	return cp;
+}
+
+/*
+ * BDF, every glyph is positioned in the FONTBOUNDINGBOX cell by its BBX.
+ * Glyphs without an encoding are skipped.
+ */
+static void load_bdf(const std::string & data, Font & font) {
+	int fw = 0, fh = 0, fx = 0, fy = 0;
+	int bw = 0, bh = 0, bx = 0, by = 0;
+	long enc = -1;
+	int row = -1;
+	std::vector<uint16_t> rows;
+	size_t pos = 0;
+
+	while (pos < data.size()) {
+		size_t end = data.find('\n', pos);
+		if (end == std::string::npos)
+			end = data.size();
+		std::string line = data.substr(pos, end - pos);
+		pos = end + 1;
+		if (!line.empty() && line[line.size()-1] == '\r')
+			line.erase(line.size()-1);
+
+		if (row >= 0) {
+			if (line == "ENDCHAR") {
+				if (enc >= 0)
+					font.glyphs[enc] = rows;
+				row = -1;
+				continue;
+			}
+			// row of the glyph box, moved to its place in the cell
+			uint32_t bits = strtoul(line.c_str(), 0, 16);
+			int y = fh + fy - by - bh + row++;
+			int shift = 16 - (bx - fx) - (int)line.size()*4;
+			if (y < 0 || y >= fh)
+				continue;
+			if (shift >= 0)
+				rows[y] |= bits << shift;
+			else
+				rows[y] |= bits >> -shift;
+			continue;
+		}
+
+		if (sscanf(line.c_str(), "FONTBOUNDINGBOX %d %d %d %d", &fw, &fh, &fx, &fy) == 4) {
+			if (fw < 1 || fw > 16 || fh < 1 || fh > 255)
+				die("font cells wider than 16 pixels are not supported");
+			font.width = fw;
+			font.height = fh;
+		}
+		else if (sscanf(line.c_str(), "ENCODING %ld", &enc) == 1)
+			;
+		else if (sscanf(line.c_str(), "BBX %d %d %d %d", &bw, &bh, &bx, &by) == 4)
+			;
+		else if (line == "BITMAP") {
+			if (!fw)
+				die("BDF without FONTBOUNDINGBOX");
+			rows.assign(fh, 0);
+			row = 0;
+		}
+	}
+	if (!fw)
+		die("not a BDF font");
+}
+
+/*
+ * PSF1 and PSF2 console fonts. Without a unicode table the glyph index is
+ * taken as the code point.
+ */
+static void load_psf(const std::string & data, Font & font) {
+	const uint8_t * d = (const uint8_t *)data.data();
+	size_t size = data.size();
+	uint32_t count, charsize, hdr, rb;
+	bool table;
+
+	if (size >= 4 && d[0] == 0x36 && d[1] == 0x04) {
+		font.width = 8;
+		font.height = d[3];
+		count = (d[2] & 1) ? 512 : 256;
+		charsize = d[3];
+		hdr = 4;
+		table = d[2] & 6;
+	}
+	else if (size >= 32 && d[0] == 0x72 && d[1] == 0xb5 && d[2] == 0x4a && d[3] == 0x86) {
+		uint32_t h[8];
+		memcpy(h, d, sizeof(h));
+		hdr = h[2];
+		table = h[3] & 1;
+		count = h[4];
+		charsize = h[5];
+		font.height = h[6];
+		font.width = h[7];
+		if (font.width < 1 || font.width > 16 || font.height < 1 || font.height > 255)
+			die("font cells wider than 16 pixels are not supported");
+	}
+	else
+		die("not a PSF font");
+
+	rb = (font.width + 7)/8;
+	if (hdr + (size_t)count*charsize > size || charsize < rb*font.height)
+		die("truncated PSF font");
+
+	std::vector<std::vector<uint16_t> > glyph(count);
+	for (uint32_t g = 0; g < count; g++) {
+		const uint8_t * p = d + hdr + g*charsize;
+		glyph[g].resize(font.height);
+		for (int y = 0; y < font.height; y++, p += rb)
+			glyph[g][y] = rb == 2 ? (p[0] << 8) | p[1] : p[0] << 8;
+	}
+
+	if (!table) {
+		for (uint32_t g = 0; g < count; g++)
+			font.glyphs[g] = glyph[g];
+		return;
+	}
+
+	// unicode table, one entry list per glyph. Sequences are skipped.
+	size_t i = hdr + (size_t)count*charsize;
+	bool psf1 = d[0] == 0x36;
+	for (uint32_t g = 0; g < count && i < size; g++) {
+		bool seq = false;
+		while (i < size) {
+			uint32_t cp;
+			if (psf1) {
+				if (i + 1 >= size)
+					break;
+				cp = d[i] | (d[i+1] << 8);
+				i += 2;
+				if (cp == 0xFFFF)
+					break;
+				if (cp == 0xFFFE) {
+					seq = true;
+					continue;
+				}
+			}
+			else {
+				if (d[i] == 0xFF) {
+					i++;
+					break;
+				}
+				if (d[i] == 0xFE) {
+					seq = true;
+					i++;
+					continue;
+				}
+				cp = utf8_next(data, i);
+			}
+			if (!seq && !font.glyphs.count(cp))
+				font.glyphs[cp] = glyph[g];
+		}
+	}
+}
+
+/*
+ * collect the characters used by text, for source files only the contents
+ * of string and character literals. Escapes other than \\ \' \" are skipped.
+ */
+static void collect(const std::string & text, bool source, std::set<uint32_t> & used) {
+	size_t i = 0;
+	char quote = 0;
+
+	while (i < text.size()) {
+		char c = text[i];
+		if (source && !quote) {
+			i++;
+			if (c == '/' && i < text.size() && text[i] == '/')
+				i = text.find('\n', i);
+			else if (c == '/' && i < text.size() && text[i] == '*') {
+				i = text.find("*/", i + 1);
+				if (i != std::string::npos)
+					i += 2;
+			}
+			else if (c == '"' || c == '\'')
+				quote = c;
+			if (i == std::string::npos)
+				break;
+			continue;
+		}
+		if (source && c == quote) {
+			quote = 0;
+			i++;
+			continue;
+		}
+		if (source && c == '\\' && i + 1 < text.size()) {
+			c = text[i+1];
+			i += 2;
+			if (c == '\\' || c == '\'' || c == '"')
+				used.insert(c);
+			continue;
+		}
+		uint32_t cp = utf8_next(text, i);
+		if (cp >= 0x20 && cp != 0x7F)
+			used.insert(cp);
+	}
+}
+
+static bool is_source(const char * path) {
+	static const char * ext[] = { ".ino", ".pde", ".c", ".cpp", ".h", ".hpp", 0 };
+	const char * dot = strrchr(path, '.');
+	for (int i = 0; dot && ext[i]; i++)
+		if (!strcmp(dot, ext[i]))
+			return true;
+	return false;
+}
+
+static std::string describe(uint32_t cp) {
+	char buf[16];
+	if (cp >= 0x21 && cp < 0x7F)
+		snprintf(buf, sizeof(buf), "%c", (char)cp);
+	else
+		snprintf(buf, sizeof(buf), "U+%04X", (unsigned)cp);
+	return buf;
+}
+
+static std::string base_name(const char * path) {
+	const char * s = strrchr(path, '/');
+	std::string name = s ? s + 1 : path;
+	size_t dot = name.find('.');
+	if (dot != std::string::npos)
+		name.erase(dot);
+	for (size_t i = 0; i < name.size(); i++)
+		if (!isalnum((unsigned char)name[i]))
+			name[i] = '_';
+	if (name.empty() || isdigit((unsigned char)name[0]))
+		name = "font_" + name;
+	return name;
+}
+
+static void usage() {
+	fprintf(stderr,
+		"usage: fontconv [-n name] [-o base] [-r first-last] [-s text] [-S file]... [-p] font\n"
+		"  converts a BDF or PSF font to a TVout font table, see the source for details\n");
+	exit(1);
+}
+
+int main(int argc, char ** argv) {
+	const char * input = 0;
+	std::string name, base, text;
+	std::vector<const char *> files;
+	unsigned first = 32, last = 126;
+	bool subset = false, packed = false;
+	Font font;
+	std::string data;
+
+	for (int i = 1; i < argc; i++) {
+		std::string a = argv[i];
+		if (a == "-n" && i + 1 < argc)
+			name = argv[++i];
+		else if (a == "-o" && i + 1 < argc)
+			base = argv[++i];
+		else if (a == "-r" && i + 1 < argc) {
+			if (sscanf(argv[++i], "%u-%u", &first, &last) != 2 || first > last || last > 255)
+				die("bad range ", argv[i]);
+		}
+		else if (a == "-s" && i + 1 < argc) {
+			text += argv[++i];
+			subset = true;
+		}
+		else if (a == "-S" && i + 1 < argc) {
+			files.push_back(argv[++i]);
+			subset = true;
+		}
+		else if (a == "-p")
+			packed = true;
+		else if (a[0] == '-')
+			usage();
+		else
+			input = argv[i];
+	}
+	if (!input)
+		usage();
+	if (!read_file(input, data))
+		die("cannot read ", input);
+
+	if (data.compare(0, 9, "STARTFONT") == 0)
+		load_bdf(data, font);
+	else
+		load_psf(data, font);
+
+	if (name.empty())
+		name = base_name(input);
+	if (base.empty())
+		base = name;
+
+	// code points of the table, in character order
+	std::vector<uint32_t> chars;
+	if (subset) {
+		std::set<uint32_t> used;
+		collect(text, false, used);
+		for (size_t i = 0; i < files.size(); i++) {
+			std::string s;
+			if (!read_file(files[i], s))
+				die("cannot read ", files[i]);
+			collect(s, is_source(files[i]), used);
+		}
+		used.insert(' ');
+		used.erase('?');
+		chars.push_back('?');
+		chars.insert(chars.end(), used.begin(), used.end());
+		if (chars.size() > 256 - '?')
+			die("subset has more than 193 characters");
+		first = '?';
+	}
+	else {
+		for (unsigned c = first; c <= last; c++)
+			chars.push_back(c);
+	}
+
+	int w = font.width, h = font.height;
+	int rb = (w + 7)/8;
+	std::vector<uint8_t> bytes;
+	uint32_t acc = 0;
+	int nacc = 0;
+	int missing = 0;
+	for (size_t i = 0; i < chars.size(); i++) {
+		std::map<uint32_t, std::vector<uint16_t> >::iterator g = font.glyphs.find(chars[i]);
+		if (g == font.glyphs.end()) {
+			if (subset || (chars[i] > 32 && chars[i] != 127))
+				fprintf(stderr, "fontconv: no glyph for %s, left blank\n", describe(chars[i]).c_str());
+			missing++;
+		}
+		for (int y = 0; y < h; y++) {
+			uint16_t r = g == font.glyphs.end() ? 0 : g->second[y];
+			if (packed) {
+				acc = (acc << w) | (r >> (16 - w));
+				nacc += w;
+				while (nacc >= 8) {
+					nacc -= 8;
+					bytes.push_back(acc >> nacc);
+				}
+			}
+			else {
+				bytes.push_back(r >> 8);
+				if (rb == 2)
+					bytes.push_back(r);
+			}
+		}
+	}
+	if (nacc)
+		bytes.push_back(acc << (8 - nacc));
+
+	// runs of the code page map
+	struct Run { uint32_t cp; unsigned len, ch; };
+	std::vector<Run> runs;
+	if (subset) {
+		std::vector<std::pair<uint32_t, unsigned> > order;
+		for (size_t i = 0; i < chars.size(); i++)
+			order.push_back(std::make_pair(chars[i], first + i));
+		std::sort(order.begin(), order.end());
+		for (size_t i = 0; i < order.size(); i++) {
+			if (order[i].first > 0xFFFF) {
+				fprintf(stderr, "fontconv: %s is beyond U+FFFF and cannot be mapped\n",
+					describe(order[i].first).c_str());
+				continue;
+			}
+			if (!runs.empty() && runs.back().len < 255 &&
+				order[i].first == runs.back().cp + runs.back().len &&
+				order[i].second == runs.back().ch + runs.back().len)
+				runs.back().len++;
+			else
+				runs.push_back(Run{order[i].first, 1, order[i].second});
+		}
+		if (runs.size() > 255)
+			die("code page map has more than 255 runs");
+	}
+
+	// font source
+	std::string cpp = base + ".cpp", hdr = base + ".h";
+	std::string guard = base_name(base.c_str());
+	for (size_t i = 0; i < guard.size(); i++)
+		guard[i] = toupper((unsigned char)guard[i]);
+	guard += "_H";
+
+	FILE * f = fopen(hdr.c_str(), "w");
+	if (!f)
+		die("cannot write ", hdr.c_str());
+	fprintf(f, "#ifndef %s\n#define %s\n\n#include <avr/pgmspace.h>\n\n", guard.c_str(), guard.c_str());
+	fprintf(f, "extern const unsigned char %s[];\n", name.c_str());
+	if (subset)
+		fprintf(f, "extern const unsigned char %s_map[];\n", name.c_str());
+	fprintf(f, "\n#endif\n");
+	fclose(f);
+
+	f = fopen(cpp.c_str(), "w");
+	if (!f)
+		die("cannot write ", cpp.c_str());
+	const char * inc = strrchr(hdr.c_str(), '/');
+	fprintf(f, "#include \"%s\"\n\n", inc ? inc + 1 : hdr.c_str());
+	fprintf(f, "/*\n * %dx%d font converted by fontconv from %s\n", w, h,
+		strrchr(input, '/') ? strrchr(input, '/') + 1 : input);
+	if (subset)
+		fprintf(f, " * %u character subset, print it with\n *\tTV.select_font(%s, %s_map);\n",
+			(unsigned)chars.size(), name.c_str(), name.c_str());
+	if (packed)
+		fprintf(f, " * rows are bit packed, %d bits each\n", w);
+	fprintf(f, " */\nPROGMEM const unsigned char %s[] = {\n\t\n", name.c_str());
+	fprintf(f, "\t%d,%d,%u,\n", packed ? w | 0x80 : w, h, first);
+	if (packed) {
+		for (size_t i = 0; i < bytes.size(); i++)
+			fprintf(f, "%s0x%02X%s", i % 12 ? " " : "\t", bytes[i],
+				i + 1 == bytes.size() ? "\n" : i % 12 == 11 ? ",\n" : ",");
+	}
+	else {
+		size_t k = 0;
+		for (size_t i = 0; i < chars.size(); i++) {
+			fprintf(f, "\t//%u %s\n", (unsigned)(first + i), describe(chars[i]).c_str());
+			for (int y = 0; y < h; y++) {
+				fprintf(f, "\t");
+				for (int b = 0; b < rb; b++, k++) {
+					fprintf(f, "0b");
+					for (int bit = 7; bit >= 0; bit--)
+						fputc(bytes[k] >> bit & 1 ? '1' : '0', f);
+					fprintf(f, "%s", k + 1 == bytes.size() ? "" : ",");
+				}
+				fprintf(f, "\n");
+			}
+		}
+	}
+	fprintf(f, "};\n");
+
+	if (subset) {
+		fprintf(f, "\n/*\n * UTF-8 code page map for %s, runs of {first code point, length, char}\n"
+			" * sorted by code point. See TVout::select_font().\n */\n", name.c_str());
+		fprintf(f, "PROGMEM const unsigned char %s_map[] = {\n\t%u,\n", name.c_str(), (unsigned)runs.size());
+		for (size_t i = 0; i < runs.size(); i++)
+			fprintf(f, "\t0x%02X,0x%02X, %u, %u%s\t// U+%04X-U+%04X\n",
+				runs[i].cp & 0xFF, runs[i].cp >> 8, runs[i].len, runs[i].ch,
+				i + 1 == runs.size() ? "" : ",",
+				(unsigned)runs[i].cp, (unsigned)(runs[i].cp + runs[i].len - 1));
+		fprintf(f, "};\n");
+	}
+	fclose(f);
+
+	fprintf(stderr, "fontconv: %s: %u glyphs %dx%d, %u bytes%s",
+		name.c_str(), (unsigned)chars.size(), w, h, (unsigned)bytes.size() + 3,
+		packed ? " packed" : "");
+	if (packed)
+		fprintf(stderr, " (%u unpacked)", (unsigned)chars.size()*rb*h + 3);
+	if (subset)
+		fprintf(stderr, ", map %u bytes", (unsigned)runs.size()*4 + 1);
+	fprintf(stderr, "\n");
+	return 0;
+}
@@ -0,0 +1,1559 @@
+#include "font6x8cyr.h"
+
+/*
+ * font6x8 extended with the cyrillic alphabet and the ukrainian letters.
+ * Characters 32-127 are identical to font6x8, 128-201 hold the cyrillic
+ * glyphs in the order given below. Use with font6x8cyr_map to print UTF-8:
+ *	TV.select_font(font6x8cyr, font6x8cyr_map);
+ */
+PROGMEM const unsigned char font6x8cyr[] = {
+	
+	6,8,32,
+	//32 Space
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	//33 Exclamation !
+	0b01000000,
+	0b01000000,
+	0b01000000,
+	0b01000000,
+	0b01000000,
+	0b00000000,
+	0b01000000,
+	0b00000000,
+	//34 Quotes "
+	0b01010000,
+	0b01010000,
+	0b01010000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	//35 Number #
+	0b00000000,
+	0b00000000,
+	0b01010000,
+	0b11111000,
+	0b01010000,
+	0b11111000,
+	0b01010000,
+	0b00000000,
+	//36 Dollars $
+	0b00100000,
+	0b01110000,
+	0b10100000,
+	0b01110000,
+	0b00101000,
+	0b01110000,
+	0b00100000,
+	0b00000000,
+	//37 Percent %
+	0b00000000,
+	0b11001000,
+	0b11010000,
+	0b00100000,
+	0b01011000,
+	0b10011000,
+	0b00000000,
+	0b00000000,
+	//38 Ampersand &
+	0b00100000,
+	0b01010000,
+	0b10000000,
+	0b01000000,
+	0b10101000,
+	0b10010000,
+	0b01101000,
+	0b00000000,
+	//39 Single Quote '
+	0b01000000,
+	0b01000000,
+	0b01000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	//40 Left Parenthesis (
+	0b00010000,
+	0b00100000,
+	0b01000000,	
+	0b01000000,
+	0b01000000,
+	0b00100000,
+	0b00010000,
+	0b00000000,
+	//41 Right Parenthesis )
+	0b01000000,
+	0b00100000,
+	0b00010000,
+	0b00010000,
+	0b00010000,
+	0b00100000,
+	0b01000000,
+	0b00000000,
+	//42 Star *
+	0b00010000,
+	0b00111000,
+	0b00010000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	//43 Plus +
+	0b00000000,
+	0b00100000,
+	0b00100000,
+	0b11111000,
+	0b00100000,
+	0b00100000,
+	0b00000000,
+	0b00000000,
+	//44 Comma ,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00010000,
+	0b00010000,
+	0b00000000,
+	//45 Minus -
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b11111000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	//46 Period .
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00010000,
+	0b00000000,
+	0b00000000,
+	// 47 Backslash /
+	0b00000000,
+	0b00001000,
+	0b00010000,
+	0b00100000,
+	0b01000000,
+	0b10000000,
+	0b00000000,
+	0b00000000,
+	// 48 Zero
+	0b01110000,
+	0b10001000,
+	0b10101000,
+	0b10101000,
+	0b10001000,
+	0b01110000,
+	0b00000000,
+	0b00000000,
+	//49 One
+	0b00100000,
+	0b01100000,
+	0b00100000,
+	0b00100000,
+	0b00100000,
+	0b01110000,
+	0b00000000,
+	0b00000000,
+	//50 two
+	0b01110000,
+	0b10001000,
+	0b00010000,
+	0b00100000,
+	0b01000000,
+	0b11111000,
+	0b00000000,
+	0b00000000,
+	 //51 Three
+	0b11111000,
+	0b00010000,
+	0b00100000,
+	0b00010000,
+	0b10001000,
+	0b01110000,
+	0b00000000,
+	0b00000000,
+	//52 Four
+	0b10010000,
+	0b10010000,
+	0b10010000,
+	0b11111000,
+	0b00010000,
+	0b00010000,
+	0b00000000,
+	0b00000000,
+	//53 Five
+	0b11111000,
+	0b10000000,
+	0b11110000,
+	0b00001000,
+	0b10001000,
+	0b01110000,
+	0b00000000,
+	0b00000000,
+	//54 Six
+	0b01110000,
+	0b10000000,
+	0b11110000,
+	0b10001000,
+	0b10001000,
+	0b01110000,
+	0b00000000,
+	0b00000000,
+	//55 Seven
+	0b11111000,
+	0b00001000,
+	0b00010000,
+	0b00100000,
+	0b01000000,
+	0b10000000,
+	0b00000000,
+	0b00000000,
+	//56 Eight
+	0b01110000,
+	0b10001000,
+	0b01110000,
+	0b10001000,
+	0b10001000,
+	0b01110000,
+	0b00000000,
+	0b00000000,
+	//57 Nine
+	0b01110000,
+	0b10001000,
+	0b10001000,
+	0b01111000,
+	0b00001000,
+	0b01110000,
+	0b00000000,
+	0b00000000,
+	//58 :
+	0b00000000,
+	0b00000000,
+	0b00100000,
+	0b00000000,
+	0b00000000,
+	0b00100000,
+	0b00000000,
+	0b00000000,
+	//59 ;
+	0b00000000,
+	0b00000000,
+	0b00100000,
+	0b00000000,
+	0b00100000,
+	0b00100000,
+	0b01000000,
+	0b00000000,
+	//60 <
+	0b00000000,
+	0b00011000,
+	0b01100000,
+	0b10000000,
+	0b01100000,
+	0b00011000,
+	0b00000000,
+	0b00000000,
+	//61 =
+	0b00000000,
+	0b00000000,
+	0b01111000,
+	0b00000000,
+	0b01111000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	//62 >
+	0b00000000,
+	0b11000000,
+	0b00110000,
+	0b00001000,
+	0b00110000,
+	0b11000000,
+	0b00000000,
+	0b00000000,
+	//63 ?
+	0b01100000,
+	0b10010000,
+	0b00100000,
+	0b00100000,
+	0b00000000,
+	0b00100000,
+	0b00000000,
+	0b00000000,
+	//64 @
+	0b01110000,
+	0b10001000,
+	0b10011000,
+	0b10101000,
+	0b10010000,
+	0b10001000,
+	0b01110000,
+	0b00000000,
+	//65 A
+	0b00100000,
+	0b01010000,
+	0b10001000,
+	0b11111000,
+	0b10001000,
+	0b10001000,
+	0b00000000,
+	0b00000000,
+	//B
+	0b11110000,
+	0b10001000,
+	0b11110000,
+	0b10001000,
+	0b10001000,
+	0b11110000,
+	0b00000000,
+	0b00000000,
+	//C
+	0b01110000,
+	0b10001000,
+	0b10000000,
+	0b10000000,
+	0b10001000,
+	0b01110000,
+	0b00000000,
+	0b00000000,
+	//D
+	0b11110000,
+	0b10001000,
+	0b10001000,
+	0b10001000,
+	0b10001000,
+	0b11110000,
+	0b00000000,
+	0b00000000,
+	//E
+	0b11111000,
+	0b10000000,
+	0b11111000,
+	0b10000000,
+	0b10000000,
+	0b11111000,
+	0b00000000,
+	0b00000000,
+	//F
+	0b11111000,
+	0b10000000,
+	0b11110000,
+	0b10000000,
+	0b10000000,
+	0b10000000,
+	0b00000000,
+	0b00000000,
+	//G
+	0b01110000,
+	0b10001000,
+	0b10000000,
+	0b10011000,
+	0b10001000,
+	0b01110000,
+	0b00000000,
+	0b00000000,
+	//H
+	0b10001000,
+	0b10001000,
+	0b11111000,
+	0b10001000,
+	0b10001000,
+	0b10001000,
+	0b00000000,
+	0b00000000,
+	//I
+	0b01110000,
+	0b00100000,
+	0b00100000,
+	0b00100000,
+	0b00100000,
+	0b01110000,
+	0b00000000,
+	0b00000000,
+	//J
+	0b00111000,
+	0b00010000,
+	0b00010000,
+	0b00010000,
+	0b10010000,
+	0b01100000,
+	0b00000000,
+	0b00000000,
+	//K
+	0b10001000,
+	0b10010000,
+	0b11100000,
+	0b10100000,
+	0b10010000,
+	0b10001000,
+	0b00000000,
+	0b00000000,
+	//L
+	0b10000000,
+	0b10000000,
+	0b10000000,
+	0b10000000,
+	0b10000000,
+	0b11111000,
+	0b00000000,
+	0b00000000,
+	//M
+	0b10001000,
+	0b11011000,
+	0b10101000,
+	0b10101000,
+	0b10001000,
+	0b10001000,
+	0b00000000,
+	0b00000000,
+	//N
+	0b10001000,
+	0b10001000,
+	0b11001000,
+	0b10101000,
+	0b10011000,
+	0b10001000,
+	0b00000000,
+	0b00000000,
+	//O
+	0b01110000,
+	0b10001000,
+	0b10001000,
+	0b10001000,
+	0b10001000,
+	0b01110000,
+	0b00000000,
+	0b00000000,
+	//P
+	0b11110000,
+	0b10001000,
+	0b11110000,
+	0b10000000,
+	0b10000000,
+	0b10000000,
+	0b00000000,
+	0b00000000,
+	//Q
+	0b01110000,
+	0b10001000,
+	0b10001000,
+	0b10101000,
+	0b10010000,
+	0b01101000,
+	0b00000000,
+	0b00000000,
+	//R
+	0b11110000,
+	0b10001000,
+	0b11110000,
+	0b10100000,
+	0b10010000,
+	0b10001000,
+	0b00000000,
+	0b00000000,
+	//S
+	0b01111000,
+	0b10000000,
+	0b01110000,
+	0b00001000,
+	0b00001000,
+	0b11110000,
+	0b00000000,
+	0b00000000,
+	//T
+	0b11111000,
+	0b00100000,
+	0b00100000,
+	0b00100000,
+	0b00100000,
+	0b00100000,
+	0b00000000,
+	0b00000000,
+	//U
+	0b10001000,
+	0b10001000,
+	0b10001000,
+	0b10001000,
+	0b10001000,
+	0b01110000,
+	0b00000000,
+	0b00000000,
+	//V
+	0b10001000,
+	0b10001000,
+	0b10001000,
+	0b10001000,
+	0b01010000,
+	0b00100000,
+	0b00000000,
+	0b00000000,
+	//W
+	0b10001000,
+	0b10001000,
+	0b10101000,
+	0b10101000,
+	0b10101000,
+	0b01010000,
+	0b00000000,
+	0b00000000,
+	//X
+	0b10001000,
+	0b01010000,
+	0b00100000,
+	0b01010000,
+	0b10001000,
+	0b10001000,
+	0b00000000,
+	0b00000000,
+	//Y
+	0b10001000,
+	0b10001000,
+	0b01010000,
+	0b00100000,
+	0b00100000,
+	0b00100000,
+	0b00000000,
+	0b00000000,
+	//Z
+	0b11111000,
+	0b00001000,
+	0b00010000,
+	0b00100000,
+	0b01000000,
+	0b11111000,
+	0b00000000,
+	0b00000000,
+	//91 [
+	0b11100000,
+	0b10000000,
+	0b10000000,
+	0b10000000,
+	0b10000000,
+	0b11100000,
+	0b00000000,
+	0b00000000,
+	//92 (backslash)
+	0b00000000,
+	0b10000000,
+	0b01000000,
+	0b00100000,
+	0b00010000,
+	0b00001000,
+	0b00000000,
+	0b00000000,
+	//93 ]
+	0b00111000,
+	0b00001000,
+	0b00001000,
+	0b00001000,
+	0b00001000,
+	0b00111000,
+	0b00000000,
+	0b00000000,
+	//94 ^
+	0b00100000,
+	0b01010000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	//95 _
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b11111000,
+	0b00000000,
+	//96 `
+	0b10000000,
+	0b01000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	//97 a
+	0b00000000,
+	0b01100000,
+	0b00010000,
+	0b01110000,
+	0b10010000,
+	0b01100000,
+	0b00000000,
+	0b00000000,
+	//98 b
+	0b10000000,
+	0b10000000,
+	0b11100000,
+	0b10010000,
+	0b10010000,
+	0b11100000,
+	0b00000000,
+	0b00000000,
+	//99 c
+	0b00000000,
+	0b00000000,
+	0b01110000,
+	0b10000000,
+	0b10000000,
+	0b01110000,
+	0b00000000,
+	0b00000000,
+	// 100 d
+	0b00010000,
+	0b00010000,
+	0b01110000,
+	0b10010000,
+	0b10010000,
+	0b01110000,
+	0b00000000,
+	0b00000000,
+	//101 e
+	0b00000000,
+	0b01100000,
+	0b10010000,
+	0b11110000,
+	0b10000000,
+	0b01110000,
+	0b00000000,
+	0b00000000,
+	//102 f
+	0b00110000,
+	0b01000000,
+	0b11100000,
+	0b01000000,
+	0b01000000,
+	0b01000000,
+	0b00000000,
+	0b00000000,
+	//103 g
+	0b00000000,
+	0b01100000,
+	0b10010000,
+	0b01110000,
+	0b00010000,
+	0b00010000,
+	0b01100000,
+	0b00000000,
+	//104 h
+	0b10000000,
+	0b10000000,
+	0b11100000,
+	0b10010000,
+	0b10010000,
+	0b10010000,
+	0b00000000,
+	0b00000000,
+	//105 i
+	0b00100000,
+	0b00000000,
+	0b00100000,
+	0b00100000,
+	0b00100000,
+	0b01110000,
+	0b00000000,
+	0b00000000,
+	//106 j
+	0b00010000,
+	0b00000000,
+	0b00110000,
+	0b00010000,
+	0b00010000,
+	0b00010000,
+	0b01100000,
+	0b00000000,
+	//107 k
+	0b10000000,
+	0b10010000,
+	0b10100000,
+	0b11000000,
+	0b10100000,
+	0b10010000,
+	0b00000000,
+	0b00000000,
+	//108 l
+	0b01100000,
+	0b00100000,
+	0b00100000,
+	0b00100000,
+	0b00100000,
+	0b01110000,
+	0b00000000,
+	0b00000000,
+	//109 m
+	0b00000000,
+	0b00000000,
+	0b01010000,
+	0b10101000,
+	0b10101000,
+	0b10101000,
+	0b00000000,
+	0b00000000,
+	//110 n
+	0b00000000,
+	0b00000000,
+	0b11110000,
+	0b10001000,
+	0b10001000,
+	0b10001000,
+	0b00000000,
+	0b00000000,
+	//111 o
+	0b00000000,
+	0b00000000,
+	0b01100000,
+	0b10010000,
+	0b10010000,
+	0b01100000,
+	0b00000000,
+	0b00000000,
+	//112 p
+	0b00000000,
+	0b00000000,
+	0b01100000,
+	0b10010000,
+	0b11110000,
+	0b10000000,
+	0b10000000,
+	0b00000000,
+	//113 q
+	0b00000000,
+	0b00000000,
+	0b01100000,
+	0b10010000,
+	0b11110000,
+	0b00010000,
+	0b00010000,
+	0b00000000,
+	//114 r
+	0b00000000,
+	0b00000000,
+	0b10110000,
+	0b01001000,
+	0b01000000,
+	0b01000000,
+	0b00000000,
+	0b00000000,
+	//115 s
+	0b00000000,
+	0b00110000,
+	0b01000000,
+	0b00100000,
+	0b00010000,
+	0b01100000,
+	0b00000000,
+	0b00000000,
+	//116 t
+	0b01000000,
+	0b01000000,
+	0b11100000,
+	0b01000000,
+	0b01000000,
+	0b01000000,
+	0b00000000,
+	0b00000000,
+	// 117u
+	0b00000000,
+	0b00000000,
+	0b10010000,
+	0b10010000,
+	0b10010000,
+	0b01100000,
+	0b00000000,
+	0b00000000,
+	//118 v
+	0b00000000,
+	0b00000000,
+	0b10001000,
+	0b10001000,
+	0b01010000,
+	0b00100000,
+	0b00000000,
+	0b00000000,
+	//119 w
+	0b00000000,
+	0b00000000,
+	0b10001000,
+	0b10101000,
+	0b10101000,
+	0b01010000,
+	0b00000000,
+	0b00000000,
+	//120 x
+	0b00000000,
+	0b10001000,
+	0b01010000,
+	0b00100000,
+	0b01010000,
+	0b10001000,
+	0b00000000,
+	0b00000000,
+	//121 y
+	0b00000000,
+	0b00000000,
+	0b10010000,
+	0b10010000,
+	0b01100000,
+	0b01000000,
+	0b10000000,
+	0b00000000,
+	//122 z
+	0b00000000,
+	0b00000000,
+	0b11110000,
+	0b00100000,
+	0b01000000,
+	0b11110000,
+	0b00000000,
+	0b00000000,
+	//123 {
+	0b00100000,
+	0b01000000,
+	0b01000000,
+	0b10000000,
+	0b01000000,
+	0b01000000,
+	0b00100000,
+	0b00000000,
+	//124 |
+	0b00100000,
+	0b00100000,
+	0b00100000,
+	0b00100000,
+	0b00100000,
+	0b00100000,
+	0b00100000,
+	0b00000000,
+	//125 }
+	0b00100000,
+	0b00010000,
+	0b00010000,
+	0b00001000,
+	0b00010000,	
+	0b00010000,
+	0b00100000,
+	0b00000000,
+	//126 ~
+	0b01000000,
+	0b10101000,
+	0b00010000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	//127 DEL
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	//128 А U+0410
+	0b00100000,
+	0b01010000,
+	0b10001000,
+	0b11111000,
+	0b10001000,
+	0b10001000,
+	0b00000000,
+	0b00000000,
+	//129 Б U+0411
+	0b11111000,
+	0b10000000,
+	0b11110000,
+	0b10001000,
+	0b10001000,
+	0b11110000,
+	0b00000000,
+	0b00000000,
+	//130 В U+0412
+	0b11110000,
+	0b10001000,
+	0b11110000,
+	0b10001000,
+	0b10001000,
+	0b11110000,
+	0b00000000,
+	0b00000000,
+	//131 Г U+0413
+	0b11111000,
+	0b10000000,
+	0b10000000,
+	0b10000000,
+	0b10000000,
+	0b10000000,
+	0b00000000,
+	0b00000000,
+	//132 Д U+0414
+	0b00110000,
+	0b01010000,
+	0b01010000,
+	0b01010000,
+	0b11111000,
+	0b10001000,
+	0b00000000,
+	0b00000000,
+	//133 Е U+0415
+	0b11111000,
+	0b10000000,
+	0b11111000,
+	0b10000000,
+	0b10000000,
+	0b11111000,
+	0b00000000,
+	0b00000000,
+	//134 Ж U+0416
+	0b10101000,
+	0b10101000,
+	0b01110000,
+	0b01110000,
+	0b10101000,
+	0b10101000,
+	0b00000000,
+	0b00000000,
+	//135 З U+0417
+	0b01110000,
+	0b10001000,
+	0b00110000,
+	0b00001000,
+	0b10001000,
+	0b01110000,
+	0b00000000,
+	0b00000000,
+	//136 И U+0418
+	0b10001000,
+	0b10011000,
+	0b10101000,
+	0b10101000,
+	0b11001000,
+	0b10001000,
+	0b00000000,
+	0b00000000,
+	//137 Й U+0419
+	0b01110000,
+	0b10001000,
+	0b10011000,
+	0b10101000,
+	0b11001000,
+	0b10001000,
+	0b00000000,
+	0b00000000,
+	//138 К U+041A
+	0b10001000,
+	0b10010000,
+	0b11100000,
+	0b10100000,
+	0b10010000,
+	0b10001000,
+	0b00000000,
+	0b00000000,
+	//139 Л U+041B
+	0b00111000,
+	0b01001000,
+	0b01001000,
+	0b01001000,
+	0b01001000,
+	0b10001000,
+	0b00000000,
+	0b00000000,
+	//140 М U+041C
+	0b10001000,
+	0b11011000,
+	0b10101000,
+	0b10101000,
+	0b10001000,
+	0b10001000,
+	0b00000000,
+	0b00000000,
+	//141 Н U+041D
+	0b10001000,
+	0b10001000,
+	0b11111000,
+	0b10001000,
+	0b10001000,
+	0b10001000,
+	0b00000000,
+	0b00000000,
+	//142 О U+041E
+	0b01110000,
+	0b10001000,
+	0b10001000,
+	0b10001000,
+	0b10001000,
+	0b01110000,
+	0b00000000,
+	0b00000000,
+	//143 П U+041F
+	0b11111000,
+	0b10001000,
+	0b10001000,
+	0b10001000,
+	0b10001000,
+	0b10001000,
+	0b00000000,
+	0b00000000,
+	//144 Р U+0420
+	0b11110000,
+	0b10001000,
+	0b11110000,
+	0b10000000,
+	0b10000000,
+	0b10000000,
+	0b00000000,
+	0b00000000,
+	//145 С U+0421
+	0b01110000,
+	0b10001000,
+	0b10000000,
+	0b10000000,
+	0b10001000,
+	0b01110000,
+	0b00000000,
+	0b00000000,
+	//146 Т U+0422
+	0b11111000,
+	0b00100000,
+	0b00100000,
+	0b00100000,
+	0b00100000,
+	0b00100000,
+	0b00000000,
+	0b00000000,
+	//147 У U+0423
+	0b10001000,
+	0b10001000,
+	0b10001000,
+	0b01111000,
+	0b00001000,
+	0b01110000,
+	0b00000000,
+	0b00000000,
+	//148 Ф U+0424
+	0b00100000,
+	0b01110000,
+	0b10101000,
+	0b10101000,
+	0b01110000,
+	0b00100000,
+	0b00000000,
+	0b00000000,
+	//149 Х U+0425
+	0b10001000,
+	0b01010000,
+	0b00100000,
+	0b01010000,
+	0b10001000,
+	0b10001000,
+	0b00000000,
+	0b00000000,
+	//150 Ц U+0426
+	0b10010000,
+	0b10010000,
+	0b10010000,
+	0b10010000,
+	0b11111000,
+	0b00001000,
+	0b00000000,
+	0b00000000,
+	//151 Ч U+0427
+	0b10001000,
+	0b10001000,
+	0b10001000,
+	0b01111000,
+	0b00001000,
+	0b00001000,
+	0b00000000,
+	0b00000000,
+	//152 Ш U+0428
+	0b10101000,
+	0b10101000,
+	0b10101000,
+	0b10101000,
+	0b10101000,
+	0b11111000,
+	0b00000000,
+	0b00000000,
+	//153 Щ U+0429
+	0b10101000,
+	0b10101000,
+	0b10101000,
+	0b10101000,
+	0b11111000,
+	0b00001100,
+	0b00000000,
+	0b00000000,
+	//154 Ъ U+042A
+	0b11000000,
+	0b01000000,
+	0b01110000,
+	0b01001000,
+	0b01001000,
+	0b01110000,
+	0b00000000,
+	0b00000000,
+	//155 Ы U+042B
+	0b10001000,
+	0b10001000,
+	0b11101000,
+	0b10101000,
+	0b10101000,
+	0b11101000,
+	0b00000000,
+	0b00000000,
+	//156 Ь U+042C
+	0b10000000,
+	0b10000000,
+	0b11110000,
+	0b10001000,
+	0b10001000,
+	0b11110000,
+	0b00000000,
+	0b00000000,
+	//157 Э U+042D
+	0b01110000,
+	0b10001000,
+	0b00111000,
+	0b00001000,
+	0b10001000,
+	0b01110000,
+	0b00000000,
+	0b00000000,
+	//158 Ю U+042E
+	0b10010000,
+	0b10101000,
+	0b11101000,
+	0b10101000,
+	0b10101000,
+	0b10010000,
+	0b00000000,
+	0b00000000,
+	//159 Я U+042F
+	0b01111000,
+	0b10001000,
+	0b10001000,
+	0b01111000,
+	0b01001000,
+	0b10001000,
+	0b00000000,
+	0b00000000,
+	//160 а U+0430
+	0b00000000,
+	0b01100000,
+	0b00010000,
+	0b01110000,
+	0b10010000,
+	0b01100000,
+	0b00000000,
+	0b00000000,
+	//161 б U+0431
+	0b00011000,
+	0b01100000,
+	0b10000000,
+	0b11110000,
+	0b10001000,
+	0b01110000,
+	0b00000000,
+	0b00000000,
+	//162 в U+0432
+	0b00000000,
+	0b00000000,
+	0b11100000,
+	0b11100000,
+	0b10010000,
+	0b11100000,
+	0b00000000,
+	0b00000000,
+	//163 г U+0433
+	0b00000000,
+	0b00000000,
+	0b11110000,
+	0b10000000,
+	0b10000000,
+	0b10000000,
+	0b00000000,
+	0b00000000,
+	//164 д U+0434
+	0b00000000,
+	0b00000000,
+	0b00110000,
+	0b01010000,
+	0b11111000,
+	0b10001000,
+	0b00000000,
+	0b00000000,
+	//165 е U+0435
+	0b00000000,
+	0b01100000,
+	0b10010000,
+	0b11110000,
+	0b10000000,
+	0b01110000,
+	0b00000000,
+	0b00000000,
+	//166 ж U+0436
+	0b00000000,
+	0b00000000,
+	0b10101000,
+	0b01110000,
+	0b01110000,
+	0b10101000,
+	0b00000000,
+	0b00000000,
+	//167 з U+0437
+	0b00000000,
+	0b00000000,
+	0b11100000,
+	0b01100000,
+	0b00010000,
+	0b11100000,
+	0b00000000,
+	0b00000000,
+	//168 и U+0438
+	0b00000000,
+	0b00000000,
+	0b10010000,
+	0b10110000,
+	0b11010000,
+	0b10010000,
+	0b00000000,
+	0b00000000,
+	//169 й U+0439
+	0b00000000,
+	0b01100000,
+	0b10010000,
+	0b10110000,
+	0b11010000,
+	0b10010000,
+	0b00000000,
+	0b00000000,
+	//170 к U+043A
+	0b00000000,
+	0b00000000,
+	0b10010000,
+	0b11100000,
+	0b10100000,
+	0b10010000,
+	0b00000000,
+	0b00000000,
+	//171 л U+043B
+	0b00000000,
+	0b00000000,
+	0b01110000,
+	0b01010000,
+	0b01010000,
+	0b10010000,
+	0b00000000,
+	0b00000000,
+	//172 м U+043C
+	0b00000000,
+	0b00000000,
+	0b10001000,
+	0b11011000,
+	0b10101000,
+	0b10001000,
+	0b00000000,
+	0b00000000,
+	//173 н U+043D
+	0b00000000,
+	0b00000000,
+	0b10010000,
+	0b11110000,
+	0b10010000,
+	0b10010000,
+	0b00000000,
+	0b00000000,
+	//174 о U+043E
+	0b00000000,
+	0b00000000,
+	0b01100000,
+	0b10010000,
+	0b10010000,
+	0b01100000,
+	0b00000000,
+	0b00000000,
+	//175 п U+043F
+	0b00000000,
+	0b00000000,
+	0b11110000,
+	0b10010000,
+	0b10010000,
+	0b10010000,
+	0b00000000,
+	0b00000000,
+	//176 р U+0440
+	0b00000000,
+	0b00000000,
+	0b01100000,
+	0b10010000,
+	0b11110000,
+	0b10000000,
+	0b10000000,
+	0b00000000,
+	//177 с U+0441
+	0b00000000,
+	0b00000000,
+	0b01110000,
+	0b10000000,
+	0b10000000,
+	0b01110000,
+	0b00000000,
+	0b00000000,
+	//178 т U+0442
+	0b00000000,
+	0b00000000,
+	0b11111000,
+	0b00100000,
+	0b00100000,
+	0b00100000,
+	0b00000000,
+	0b00000000,
+	//179 у U+0443
+	0b00000000,
+	0b00000000,
+	0b10010000,
+	0b10010000,
+	0b01110000,
+	0b00010000,
+	0b01100000,
+	0b00000000,
+	//180 ф U+0444
+	0b00000000,
+	0b00100000,
+	0b01110000,
+	0b10101000,
+	0b10101000,
+	0b01110000,
+	0b00100000,
+	0b00000000,
+	//181 х U+0445
+	0b00000000,
+	0b10001000,
+	0b01010000,
+	0b00100000,
+	0b01010000,
+	0b10001000,
+	0b00000000,
+	0b00000000,
+	//182 ц U+0446
+	0b00000000,
+	0b00000000,
+	0b10010000,
+	0b10010000,
+	0b10010000,
+	0b11111000,
+	0b00001000,
+	0b00000000,
+	//183 ч U+0447
+	0b00000000,
+	0b00000000,
+	0b10010000,
+	0b10010000,
+	0b01110000,
+	0b00010000,
+	0b00000000,
+	0b00000000,
+	//184 ш U+0448
+	0b00000000,
+	0b00000000,
+	0b10101000,
+	0b10101000,
+	0b10101000,
+	0b11111000,
+	0b00000000,
+	0b00000000,
+	//185 щ U+0449
+	0b00000000,
+	0b00000000,
+	0b10101000,
+	0b10101000,
+	0b10101000,
+	0b11111100,
+	0b00000100,
+	0b00000000,
+	//186 ъ U+044A
+	0b00000000,
+	0b00000000,
+	0b11000000,
+	0b01110000,
+	0b01001000,
+	0b01110000,
+	0b00000000,
+	0b00000000,
+	//187 ы U+044B
+	0b00000000,
+	0b00000000,
+	0b10001000,
+	0b11101000,
+	0b10101000,
+	0b11101000,
+	0b00000000,
+	0b00000000,
+	//188 ь U+044C
+	0b00000000,
+	0b00000000,
+	0b10000000,
+	0b11100000,
+	0b10010000,
+	0b11100000,
+	0b00000000,
+	0b00000000,
+	//189 э U+044D
+	0b00000000,
+	0b00000000,
+	0b11100000,
+	0b01110000,
+	0b00010000,
+	0b11100000,
+	0b00000000,
+	0b00000000,
+	//190 ю U+044E
+	0b00000000,
+	0b00000000,
+	0b10110000,
+	0b11001000,
+	0b10001000,
+	0b10110000,
+	0b00000000,
+	0b00000000,
+	//191 я U+044F
+	0b00000000,
+	0b00000000,
+	0b01110000,
+	0b10010000,
+	0b01110000,
+	0b10010000,
+	0b00000000,
+	0b00000000,
+	//192 Ё U+0401
+	0b01010000,
+	0b11111000,
+	0b10000000,
+	0b11110000,
+	0b10000000,
+	0b11111000,
+	0b00000000,
+	0b00000000,
+	//193 Є U+0404
+	0b01110000,
+	0b10001000,
+	0b11110000,
+	0b10000000,
+	0b10001000,
+	0b01110000,
+	0b00000000,
+	0b00000000,
+	//194 І U+0406
+	0b01110000,
+	0b00100000,
+	0b00100000,
+	0b00100000,
+	0b00100000,
+	0b01110000,
+	0b00000000,
+	0b00000000,
+	//195 Ї U+0407
+	0b01010000,
+	0b01110000,
+	0b00100000,
+	0b00100000,
+	0b00100000,
+	0b01110000,
+	0b00000000,
+	0b00000000,
+	//196 ё U+0451
+	0b01010000,
+	0b00000000,
+	0b01100000,
+	0b11110000,
+	0b10000000,
+	0b01110000,
+	0b00000000,
+	0b00000000,
+	//197 є U+0454
+	0b00000000,
+	0b00000000,
+	0b01100000,
+	0b11100000,
+	0b10010000,
+	0b01100000,
+	0b00000000,
+	0b00000000,
+	//198 і U+0456
+	0b00100000,
+	0b00000000,
+	0b00100000,
+	0b00100000,
+	0b00100000,
+	0b01110000,
+	0b00000000,
+	0b00000000,
+	//199 ї U+0457
+	0b01010000,
+	0b00000000,
+	0b00100000,
+	0b00100000,
+	0b00100000,
+	0b01110000,
+	0b00000000,
+	0b00000000,
+	//200 Ґ U+0490
+	0b00001000,
+	0b11111000,
+	0b10000000,
+	0b10000000,
+	0b10000000,
+	0b10000000,
+	0b00000000,
+	0b00000000,
+	//201 ґ U+0491
+	0b00000000,
+	0b00010000,
+	0b11110000,
+	0b10000000,
+	0b10000000,
+	0b10000000,
+	0b00000000,
+	0b00000000
+};
+
+/*
+ * UTF-8 code page map for font6x8cyr, runs of {first code point, length, char}
+ * sorted by code point. See TVout::select_font().
+ */
+PROGMEM const unsigned char font6x8cyr_map[] = {
+	9,
+	0x20,0x00, 96, 32,	// U+0020-U+007F
+	0x01,0x04, 1, 192,	// U+0401-U+0401
+	0x04,0x04, 1, 193,	// U+0404-U+0404
+	0x06,0x04, 2, 194,	// U+0406-U+0407
+	0x10,0x04, 64, 128,	// U+0410-U+044F
+	0x51,0x04, 1, 196,	// U+0451-U+0451
+	0x54,0x04, 1, 197,	// U+0454-U+0454
+	0x56,0x04, 2, 198,	// U+0456-U+0457
+	0x90,0x04, 2, 200	// U+0490-U+0491
+};
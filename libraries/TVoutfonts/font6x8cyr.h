@@ -0,0 +1,9 @@
+#ifndef FONT6X8CYR_H
+#define FONT6X8CYR_H
+
+#include <avr/pgmspace.h>
+
+extern const unsigned char font6x8cyr[];
+extern const unsigned char font6x8cyr_map[];
+
+#endif
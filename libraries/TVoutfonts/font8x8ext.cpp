@@ -258,4 +258,46 @@ PROGMEM const unsigned char font8x8ext[] = {
 0x3E, 0x61, 0x3C, 0x66, 0x66, 0x3C, 0x86, 0x7C, 
 0x00, 0x00, 0x3C, 0x3C, 0x3C, 0x3C, 0x00, 0x00, 
 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};
\ No newline at end of file
+};
+
+/*
+ * UTF-8 code page map for font8x8ext. Characters 128-255 of the font follow
+ * code page 855 (DOS cyrillic), runs of {first code point, length, char} are
+ * sorted by code point. See TVout::select_font().
+ */
+PROGMEM const unsigned char font8x8ext_map[] = {
+127,
+0x20, 0x00, 96, 0x20,
+0xA0, 0x00, 1, 0xFF, 0xA4, 0x00, 1, 0xCF, 0xA7, 0x00, 1, 0xFD, 0xAB, 0x00, 1, 0xAE, 
+0xAD, 0x00, 1, 0xF0, 0xBB, 0x00, 1, 0xAF, 0x01, 0x04, 1, 0x85, 0x02, 0x04, 1, 0x81, 
+0x03, 0x04, 1, 0x83, 0x04, 0x04, 1, 0x87, 0x05, 0x04, 1, 0x89, 0x06, 0x04, 1, 0x8B, 
+0x07, 0x04, 1, 0x8D, 0x08, 0x04, 1, 0x8F, 0x09, 0x04, 1, 0x91, 0x0A, 0x04, 1, 0x93, 
+0x0B, 0x04, 1, 0x95, 0x0C, 0x04, 1, 0x97, 0x0E, 0x04, 1, 0x99, 0x0F, 0x04, 1, 0x9B, 
+0x10, 0x04, 1, 0xA1, 0x11, 0x04, 1, 0xA3, 0x12, 0x04, 1, 0xEC, 0x13, 0x04, 1, 0xAD, 
+0x14, 0x04, 1, 0xA7, 0x15, 0x04, 1, 0xA9, 0x16, 0x04, 1, 0xEA, 0x17, 0x04, 1, 0xF4, 
+0x18, 0x04, 1, 0xB8, 0x19, 0x04, 1, 0xBE, 0x1A, 0x04, 1, 0xC7, 0x1B, 0x04, 1, 0xD1, 
+0x1C, 0x04, 1, 0xD3, 0x1D, 0x04, 1, 0xD5, 0x1E, 0x04, 1, 0xD7, 0x1F, 0x04, 1, 0xDD, 
+0x20, 0x04, 1, 0xE2, 0x21, 0x04, 1, 0xE4, 0x22, 0x04, 1, 0xE6, 0x23, 0x04, 1, 0xE8, 
+0x24, 0x04, 1, 0xAB, 0x25, 0x04, 1, 0xB6, 0x26, 0x04, 1, 0xA5, 0x27, 0x04, 1, 0xFC, 
+0x28, 0x04, 1, 0xF6, 0x29, 0x04, 1, 0xFA, 0x2A, 0x04, 1, 0x9F, 0x2B, 0x04, 1, 0xF2, 
+0x2C, 0x04, 1, 0xEE, 0x2D, 0x04, 1, 0xF8, 0x2E, 0x04, 1, 0x9D, 0x2F, 0x04, 1, 0xE0, 
+0x30, 0x04, 1, 0xA0, 0x31, 0x04, 1, 0xA2, 0x32, 0x04, 1, 0xEB, 0x33, 0x04, 1, 0xAC, 
+0x34, 0x04, 1, 0xA6, 0x35, 0x04, 1, 0xA8, 0x36, 0x04, 1, 0xE9, 0x37, 0x04, 1, 0xF3, 
+0x38, 0x04, 1, 0xB7, 0x39, 0x04, 1, 0xBD, 0x3A, 0x04, 1, 0xC6, 0x3B, 0x04, 1, 0xD0, 
+0x3C, 0x04, 1, 0xD2, 0x3D, 0x04, 1, 0xD4, 0x3E, 0x04, 1, 0xD6, 0x3F, 0x04, 1, 0xD8, 
+0x40, 0x04, 1, 0xE1, 0x41, 0x04, 1, 0xE3, 0x42, 0x04, 1, 0xE5, 0x43, 0x04, 1, 0xE7, 
+0x44, 0x04, 1, 0xAA, 0x45, 0x04, 1, 0xB5, 0x46, 0x04, 1, 0xA4, 0x47, 0x04, 1, 0xFB, 
+0x48, 0x04, 1, 0xF5, 0x49, 0x04, 1, 0xF9, 0x4A, 0x04, 1, 0x9E, 0x4B, 0x04, 1, 0xF1, 
+0x4C, 0x04, 1, 0xED, 0x4D, 0x04, 1, 0xF7, 0x4E, 0x04, 1, 0x9C, 0x4F, 0x04, 1, 0xDE, 
+0x51, 0x04, 1, 0x84, 0x52, 0x04, 1, 0x80, 0x53, 0x04, 1, 0x82, 0x54, 0x04, 1, 0x86, 
+0x55, 0x04, 1, 0x88, 0x56, 0x04, 1, 0x8A, 0x57, 0x04, 1, 0x8C, 0x58, 0x04, 1, 0x8E, 
+0x59, 0x04, 1, 0x90, 0x5A, 0x04, 1, 0x92, 0x5B, 0x04, 1, 0x94, 0x5C, 0x04, 1, 0x96, 
+0x5E, 0x04, 1, 0x98, 0x5F, 0x04, 1, 0x9A, 0x16, 0x21, 1, 0xEF, 0x00, 0x25, 1, 0xC4, 
+0x02, 0x25, 1, 0xB3, 0x0C, 0x25, 1, 0xDA, 0x10, 0x25, 1, 0xBF, 0x14, 0x25, 1, 0xC0, 
+0x18, 0x25, 1, 0xD9, 0x1C, 0x25, 1, 0xC3, 0x24, 0x25, 1, 0xB4, 0x2C, 0x25, 1, 0xC2, 
+0x34, 0x25, 1, 0xC1, 0x3C, 0x25, 1, 0xC5, 0x50, 0x25, 1, 0xCD, 0x51, 0x25, 1, 0xBA, 
+0x54, 0x25, 1, 0xC9, 0x57, 0x25, 1, 0xBB, 0x5A, 0x25, 1, 0xC8, 0x5D, 0x25, 1, 0xBC, 
+0x60, 0x25, 1, 0xCC, 0x63, 0x25, 1, 0xB9, 0x66, 0x25, 1, 0xCB, 0x69, 0x25, 1, 0xCA, 
+0x6C, 0x25, 1, 0xCE, 0x80, 0x25, 1, 0xDF, 0x84, 0x25, 1, 0xDC, 0x88, 0x25, 1, 0xDB, 
+0x91, 0x25, 3, 0xB0, 0xA0, 0x25, 1, 0xFE
+};
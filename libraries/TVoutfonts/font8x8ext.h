@@ -3,5 +3,6 @@
 
 #include <avr/pgmspace.h>
 extern const unsigned char font8x8ext[];
+extern const unsigned char font8x8ext_map[];
 
 #endif
\ No newline at end of file
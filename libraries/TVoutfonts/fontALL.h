@@ -4,7 +4,9 @@
 #include "font3x5.h"
 #include "font4x6.h"
 #include "font6x8.h"
+#include "font6x8cyr.h"
 #include "font8x8.h"
 #include "font8x8ext.h"
+#include "fontstroke.h"
 
 #endif
\ No newline at end of file
@@ -0,0 +1,151 @@
+#include "fontstroke.h"
+
+/*
+ * Stroke font for TVout::draw_string(), characters 32-95 (lower case letters
+ * are drawn as upper case). Glyphs sit on a 7x9 grid with the baseline at 8.
+ *
+ * Layout:
+ *	first char, char count, height, advance,
+ *	offset of each glyph from the start of the font (16 bit),
+ *	glyph data: one byte per point (x<<4 | y), 0xFE lifts the pen,
+ *	0xFF ends the glyph.
+ */
+PROGMEM const unsigned char font_stroke[] = {
+	32,64,9,8,
+	132,0, 133,0, 139,0, 145,0, 157,0, 173,0, 188,0, 201,0,
+	204,0, 209,0, 214,0, 223,0, 229,0, 233,0, 236,0, 239,0,
+	242,0, 252,0, 3,1, 11,1, 21,1, 26,1, 36,1, 48,1,
+	52,1, 71,1, 83,1, 89,1, 96,1, 100,1, 106,1, 110,1,
+	120,1, 134,1, 141,1, 155,1, 164,1, 172,1, 180,1, 187,1,
+	198,1, 207,1, 216,1, 222,1, 231,1, 235,1, 241,1, 246,1,
+	0,2, 8,2, 21,2, 32,2, 45,2, 51,2, 58,2, 62,2,
+	68,2, 74,2, 81,2, 86,2, 91,2, 94,2, 99,2, 103,2,
+	//32 space
+	0xFF,
+	//33 !
+	0x30, 0x35, 0xFE, 0x37, 0x38, 0xFF,
+	//34 "
+	0x20, 0x22, 0xFE, 0x40, 0x42, 0xFF,
+	//35 #
+	0x21, 0x17, 0xFE, 0x51, 0x47, 0xFE, 0x03, 0x63, 0xFE, 0x05, 0x65, 0xFF,
+	//36 $
+	0x61, 0x50, 0x10, 0x01, 0x03, 0x14, 0x54, 0x65, 0x67, 0x58, 0x18, 0x07, 0xFE, 0x30, 0x38, 0xFF,
+	//37 %
+	0x08, 0x60, 0xFE, 0x10, 0x01, 0x12, 0x21, 0x10, 0xFE, 0x56, 0x47, 0x58, 0x67, 0x56, 0xFF,
+	//38 &
+	0x68, 0x12, 0x11, 0x20, 0x30, 0x41, 0x42, 0x05, 0x07, 0x18, 0x38, 0x65, 0xFF,
+	//39 quote
+	0x30, 0x32, 0xFF,
+	//40 (
+	0x40, 0x22, 0x26, 0x48, 0xFF,
+	//41 )
+	0x20, 0x42, 0x46, 0x28, 0xFF,
+	//42 *
+	0x31, 0x37, 0xFE, 0x02, 0x66, 0xFE, 0x06, 0x62, 0xFF,
+	//43 +
+	0x31, 0x37, 0xFE, 0x04, 0x64, 0xFF,
+	//44 ,
+	0x37, 0x38, 0x2A, 0xFF,
+	//45 -
+	0x14, 0x54, 0xFF,
+	//46 .
+	0x37, 0x38, 0xFF,
+	//47 /
+	0x08, 0x60, 0xFF,
+	//48 0
+	0x20, 0x40, 0x62, 0x66, 0x48, 0x28, 0x06, 0x02, 0x20, 0xFF,
+	//49 1
+	0x12, 0x30, 0x38, 0xFE, 0x18, 0x58, 0xFF,
+	//50 2
+	0x02, 0x10, 0x50, 0x61, 0x63, 0x08, 0x68, 0xFF,
+	//51 3
+	0x00, 0x60, 0x33, 0x53, 0x64, 0x67, 0x58, 0x18, 0x07, 0xFF,
+	//52 4
+	0x58, 0x50, 0x06, 0x66, 0xFF,
+	//53 5
+	0x60, 0x00, 0x03, 0x53, 0x64, 0x67, 0x58, 0x18, 0x07, 0xFF,
+	//54 6
+	0x50, 0x20, 0x02, 0x07, 0x18, 0x58, 0x67, 0x65, 0x54, 0x14, 0x05, 0xFF,
+	//55 7
+	0x00, 0x60, 0x28, 0xFF,
+	//56 8
+	0x10, 0x50, 0x61, 0x63, 0x54, 0x14, 0x05, 0x07, 0x18, 0x58, 0x67, 0x65, 0x54, 0xFE, 0x14, 0x03, 0x01, 0x10, 0xFF,
+	//57 9
+	0x63, 0x54, 0x14, 0x03, 0x01, 0x10, 0x50, 0x61, 0x66, 0x48, 0x18, 0xFF,
+	//58 :
+	0x32, 0x33, 0xFE, 0x37, 0x38, 0xFF,
+	//59 ;
+	0x32, 0x33, 0xFE, 0x37, 0x38, 0x2A, 0xFF,
+	//60 <
+	0x61, 0x04, 0x67, 0xFF,
+	//61 =
+	0x03, 0x63, 0xFE, 0x05, 0x65, 0xFF,
+	//62 >
+	0x01, 0x64, 0x07, 0xFF,
+	//63 ?
+	0x02, 0x10, 0x50, 0x61, 0x63, 0x35, 0xFE, 0x37, 0x38, 0xFF,
+	//64 @
+	0x45, 0x43, 0x23, 0x25, 0x45, 0x65, 0x62, 0x40, 0x20, 0x02, 0x06, 0x28, 0x58, 0xFF,
+	//65 A
+	0x08, 0x30, 0x68, 0xFE, 0x15, 0x55, 0xFF,
+	//66 B
+	0x08, 0x00, 0x40, 0x51, 0x53, 0x44, 0x04, 0xFE, 0x44, 0x65, 0x67, 0x58, 0x08, 0xFF,
+	//67 C
+	0x61, 0x50, 0x20, 0x02, 0x06, 0x28, 0x58, 0x67, 0xFF,
+	//68 D
+	0x00, 0x08, 0x38, 0x65, 0x63, 0x30, 0x00, 0xFF,
+	//69 E
+	0x60, 0x00, 0x08, 0x68, 0xFE, 0x04, 0x44, 0xFF,
+	//70 F
+	0x60, 0x00, 0x08, 0xFE, 0x04, 0x44, 0xFF,
+	//71 G
+	0x61, 0x50, 0x20, 0x02, 0x06, 0x28, 0x58, 0x67, 0x64, 0x34, 0xFF,
+	//72 H
+	0x00, 0x08, 0xFE, 0x60, 0x68, 0xFE, 0x04, 0x64, 0xFF,
+	//73 I
+	0x10, 0x50, 0xFE, 0x30, 0x38, 0xFE, 0x18, 0x58, 0xFF,
+	//74 J
+	0x60, 0x66, 0x48, 0x28, 0x06, 0xFF,
+	//75 K
+	0x00, 0x08, 0xFE, 0x60, 0x05, 0xFE, 0x23, 0x68, 0xFF,
+	//76 L
+	0x00, 0x08, 0x68, 0xFF,
+	//77 M
+	0x08, 0x00, 0x34, 0x60, 0x68, 0xFF,
+	//78 N
+	0x08, 0x00, 0x68, 0x60, 0xFF,
+	//79 O
+	0x20, 0x40, 0x62, 0x66, 0x48, 0x28, 0x06, 0x02, 0x20, 0xFF,
+	//80 P
+	0x08, 0x00, 0x50, 0x61, 0x63, 0x54, 0x04, 0xFF,
+	//81 Q
+	0x20, 0x40, 0x62, 0x66, 0x48, 0x28, 0x06, 0x02, 0x20, 0xFE, 0x35, 0x68, 0xFF,
+	//82 R
+	0x08, 0x00, 0x50, 0x61, 0x63, 0x54, 0x04, 0xFE, 0x34, 0x68, 0xFF,
+	//83 S
+	0x61, 0x50, 0x10, 0x01, 0x03, 0x14, 0x54, 0x65, 0x67, 0x58, 0x18, 0x07, 0xFF,
+	//84 T
+	0x00, 0x60, 0xFE, 0x30, 0x38, 0xFF,
+	//85 U
+	0x00, 0x06, 0x28, 0x48, 0x66, 0x60, 0xFF,
+	//86 V
+	0x00, 0x38, 0x60, 0xFF,
+	//87 W
+	0x00, 0x18, 0x34, 0x58, 0x60, 0xFF,
+	//88 X
+	0x00, 0x68, 0xFE, 0x60, 0x08, 0xFF,
+	//89 Y
+	0x00, 0x34, 0x60, 0xFE, 0x34, 0x38, 0xFF,
+	//90 Z
+	0x00, 0x60, 0x08, 0x68, 0xFF,
+	//91 [
+	0x40, 0x20, 0x28, 0x48, 0xFF,
+	//92 backslash
+	0x00, 0x68, 0xFF,
+	//93 ]
+	0x20, 0x40, 0x48, 0x28, 0xFF,
+	//94 ^
+	0x13, 0x30, 0x53, 0xFF,
+	//95 _
+	0x09, 0x69, 0xFF
+};
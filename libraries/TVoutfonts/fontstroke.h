@@ -0,0 +1,8 @@
+#ifndef FONTSTROKE_H
+#define FONTSTROKE_H
+
+#include <avr/pgmspace.h>
+
+extern const unsigned char font_stroke[];
+
+#endif